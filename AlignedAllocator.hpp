@@ -0,0 +1,35 @@
+/* This hpp file declares an allocator which aligns every allocation,
+e.g. to a cache line, so that the buffer can be read with aligned
+vector loads */
+
+#ifndef ALIGNEDALLOCATOR_H
+#define ALIGNEDALLOCATOR_H
+
+#include <cstddef>
+#include <new>
+
+template <typename T, std::size_t Alignment>
+struct AlignedAllocator_t
+{
+	typedef T value_type;
+	template <typename U> struct rebind { typedef AlignedAllocator_t<U, Alignment> other; };
+
+	AlignedAllocator_t() {}
+	template <typename U> AlignedAllocator_t(const AlignedAllocator_t<U, Alignment>&) {}
+
+	T* allocate(std::size_t n)
+	{
+		return static_cast<T*>(::operator new(n*sizeof(T), std::align_val_t(Alignment)));
+	}
+	void deallocate(T *p, std::size_t)
+	{
+		::operator delete(p, std::align_val_t(Alignment));
+	}
+
+	template <typename U>
+	bool operator==(const AlignedAllocator_t<U, Alignment>&) const { return true; }
+	template <typename U>
+	bool operator!=(const AlignedAllocator_t<U, Alignment>&) const { return false; }
+};
+
+#endif
@@ -5,267 +5,186 @@ with specified start and goal */
 #include <iostream>
 #include <cmath>
 #include <algorithm>
+#include <limits>
 
 #include "Graph.hpp"
 #include "AstarSolver.hpp"
 #include "Timer.hpp"
 
-AstarSolver_t::AstarSolver_t(Graph_t &g, int start, std::vector<int> goalSet)
+AstarSolver_t::AstarSolver_t(const Graph_t &g, int start, std::vector<int> goalSet, 
+							HeuristicMode_t heuristic) : m_heuristic(heuristic), m_openBack(&m_nodes)
+{
+	reset(g, start, goalSet);
+}
+
+void AstarSolver_t::reset(const Graph_t &g, int start, std::vector<int> goalSet)
 {
 	// initialize the start & goal
-	m_start = start;
-	m_goalSet = goalSet;
-	m_targetPoses = g.getTargetPoses();
-	for (int i=0; i < m_goalSet.size(); i++)
-	{
-		m_goalmap[m_goalSet[i]] = m_targetPoses[i];
-	}
+	init_goals(g, start, goalSet);
 	// essential elements for Astar search
-	computeH(g); // heuristics
-	m_G = std::vector<float>(g.getnNodes(), std::numeric_limits<float>::max());
-	m_G[m_start] = 0.0;
-	m_open.push(new AstarNode_t(m_start, m_H[m_start], m_G[m_start]+m_H[m_start], nullptr));
-	m_expanded = std::vector<bool>(g.getnNodes(), false);
+	computeH(g, m_heuristic); // heuristics
+	m_G.init(g.getnNodes(), std::numeric_limits<float>::max());
+	m_G.at(m_start) = 0.0;
+	m_open.push(m_start, m_nodes.create(m_start, m_H[m_start], m_G[m_start]+m_H[m_start], -1));
+	m_expanded.init(g.getnNodes());
+}
 
-	m_isFailure = false;
-	
+void AstarSolver_t::computeH(const Graph_t &g, HeuristicMode_t heuristic)
+{
+	m_H.build(g, m_goalSet, *m_goalTable, heuristic);
 }
 
-AstarSolver_t::~AstarSolver_t()
+void AstarSolver_t::Astar_search(const Graph_t &g)
 {
-	while (!m_open.empty())
-	{
-		AstarNode_t* a1 = m_open.top();
-		delete a1;
-		m_open.pop();
-	}
-	for (auto &e : m_closed) { delete e; }
+	search(g);
 }
 
-void AstarSolver_t::computeH(Graph_t &g)
+void AstarSolver_t::AstarBidirectional_search(const Graph_t &g)
 {
-	std::vector<float> goal_mean = std::vector<float>(g.getState(0).size(), 0.0);
-	for (auto const &goal : m_goalSet)
+	const float infinity = std::numeric_limits<float>::max();
+	// direction 0 is forward, 1 is backward. The forward side starts over here so that
+	// the search does not depend on what ran since reset() (its heuristic is kept)
+	init_goals(g, m_start, m_goalSet);
+	m_G.init(g.getnNodes(), infinity);
+	m_G.at(m_start) = 0.0;
+	m_expanded.init(g.getnNodes());
+	if (m_heuristic == HEURISTIC_COSTTOGO)
 	{
-		std::vector<float> v_goal = g.getState(goal);
-		for (int j=0; j < v_goal.size(); j++)
-		{
-			goal_mean[j] = goal_mean[j] + v_goal[j];
-		}
+		// h is exact: the forward search alone expands only the nodes of optimal paths,
+		// a backward side could only add expansions
+		m_open.push(m_start, m_nodes.create(m_start, m_H[m_start], m_H[m_start], -1));
+		search(g);
+		return;
 	}
-	for (int j=0; j < goal_mean.size(); j++)
+	m_openBack.init(g.getnNodes());
+	m_GBack.init(g.getnNodes(), infinity);
+	m_expandedBack.init(g.getnNodes());
+	// h to the start. An eager table would be computed (and kept by the graph) for
+	// every start, so the goal mean mode uses the lazy goal mean backward
+	m_startTable.build(g.getnNodes(), std::vector<int>(1, m_start), std::vector<int>(1, 0));
+	HeuristicMode_t backMode = m_heuristic;
+	if (backMode == HEURISTIC_GOALMEAN)
 	{
-		goal_mean[j] = goal_mean[j] / m_goalSet.size();
+		backMode = HEURISTIC_GOALMEAN_LAZY;
 	}
-
-	std::vector<float> temp_v;
-	for (int i=0; i < g.getnNodes(); i++)
+	m_HBack.build(g, std::vector<int>(1, m_start), m_startTable, backMode);
+
+	IndexedOpenList_t<AstarNode_t, AstarNode_comparison> *open[2] = {&m_open, &m_openBack};
+	StampedArray_t<float> *G[2] = {&m_G, &m_GBack};
+	StampedSet_t *expanded[2] = {&m_expanded, &m_expandedBack};
+	StampedArray_t<int> *best = m_bestNode;
+	best[0].init(g.getnNodes(), -1);
+	best[1].init(g.getnNodes(), -1);
+	best[0].at(m_start) = m_nodes.create(m_start, potential(m_start), potential(m_start), -1);
+	m_open.push(m_start, best[0][m_start]);
+
+	// the best path found so far goes through the nodes meet[0] (forward) and meet[1]
+	float mu = infinity;
+	int meet[2] = {-1, -1};
+	for (auto const &goal : m_goalSet)
 	{
-		if (std::find(m_goalSet.begin(), m_goalSet.end(), i) != m_goalSet.end())
-		{
-			m_H.push_back(0.0);
-			continue;
-		}
-		// compute euclidean distance
-		float temp_h = 0.0;
-		temp_v = g.getState(i);
-		for (int j=0; j < goal_mean.size(); j++)
+		if (m_GBack[goal] == 0.0 or potential(goal) == std::numeric_limits<float>::infinity()) { continue; }
+		m_GBack.at(goal) = 0.0;
+		best[1].at(goal) = m_nodes.create(goal, -potential(goal), -potential(goal), -1);
+		m_openBack.push(goal, best[1][goal]);
+		if (goal == m_start)
 		{
-			temp_h += pow(goal_mean[j]-temp_v[j], 2);
+			mu = 0.0;
+			meet[0] = best[0][m_start];
+			meet[1] = best[1][goal];
 		}
-		temp_h = sqrt(temp_h);
-		m_H.push_back(temp_h);
 	}
 
-}
-
-void AstarSolver_t::Astar_search(Graph_t &g)
-{
-	while (!m_open.empty())
+	while (!m_open.empty() and !m_openBack.empty())
 	{
-		AstarNode_t *current = m_open.top();
-		m_open.pop();
-		// Now check if the current node has been expanded
-		if (m_expanded[current->m_id] == true)
-		{
-			// This node has been expanded with the lowest f value for its id
-			// No need to put it into the closed list
-			delete current;
-			continue;
-		}
-		m_closed.push_back(current);
-		m_expanded[current->m_id] = true;
-
-		// a goal in the goalSet has been found
-		if ( std::find(m_goalSet.begin(), m_goalSet.end(), current->m_id) != m_goalSet.end() ) 
+		// the potentials of the two sides add up to 0, so no path through the open nodes
+		// is cheaper than the sum of the lowest f of each side
+		if (m_nodes[m_open.top()].m_f + m_nodes[m_openBack.top()].m_f >= mu) { break; }
+		// expand the side with the smaller frontier
+		int dir = (m_open.size() <= m_openBack.size()) ? 0 : 1;
+		int currentIdx = open[dir]->pop();
+		int current = m_nodes[currentIdx].m_id;
+		expanded[dir]->insert(current);
+		m_closed.push_back(currentIdx);
+		ConstRange_t<int> neighbors = g.getNodeNeighbors(current);
+		ConstRange_t<int> edges = g.getNodeEdges(current);
+		for (int k=0; k < neighbors.size(); k++)
 		{
-			std::cout << "Goal is connected all the way to the start\n";
-			back_track_path(); // construct your path
-			pathToTrajectory(g); // get the trajectory (a sequence of configurations)
-			computeLabels(g); // get the labels the path carries
-			// printLabels();
-			// print the pose the goal indicates
-			m_goalIdxReached = m_goalmap[current->m_id];
-			m_pathCost = current->m_f;
-			// std::cout << "The reaching target pose is: " << m_goalIdxReached << "\n";
-			// std::cout << "The cost: " << m_pathCost << "\n";
-
-			return;
-		}
-		// get neighbors of the current node
-		std::vector<int> neighbors = g.getNodeNeighbors(current->m_id);
-		for (auto const &neighbor : neighbors)
-		{
-			// check if the neighbor node has been visited or extended before
-			if ( m_expanded[neighbor] ) {continue;}
-			if ( m_G[neighbor] > m_G[current->m_id] + g.getEdgeCost(current->m_id, neighbor) )
+			int neighbor = neighbors[k];
+			if ((*expanded[dir])[neighbor]) { continue; }
+			float temp_g = (*G[dir])[current] + g.getEdgeCostById(edges[k]);
+			if (temp_g >= (*G[dir])[neighbor]) { continue; }
+			float p = potential(neighbor);
+			if (p == std::numeric_limits<float>::infinity()) { continue; }
+			G[dir]->at(neighbor) = temp_g;
+			float h = (dir == 0) ? p : -p;
+			best[dir].at(neighbor) = m_nodes.create(neighbor, h, temp_g+h, currentIdx);
+			open[dir]->push(neighbor, best[dir][neighbor]);
+			// the other side has reached the neighbor as well: a path
+			float other_g = (*G[1-dir])[neighbor];
+			if (other_g != infinity and temp_g + other_g < mu)
 			{
-				m_G[neighbor] = m_G[current->m_id] + g.getEdgeCost(current->m_id, neighbor);
-				m_open.push(new AstarNode_t(neighbor, m_H[neighbor], 
-													m_G[neighbor]+m_H[neighbor], current));
+				mu = temp_g + other_g;
+				meet[dir] = best[dir][neighbor];
+				meet[1-dir] = best[1-dir][neighbor];
 			}
 		}
 	}
-	// You are reaching here since the open list is empty and the goal is not found
-	std::cout << "The problem is not solvable. Search failed...\n";
-	m_isFailure = true;
-}
-
-void AstarSolver_t::checkPathSuccess(int nhypo)
-{
-	m_obstaclesCollided = 0;
-	m_isPathSuccess = true;
-	// compute the obstacles collided
-	// loop through the m_goalLabels
-	for (auto const &l : m_goalLabels)
-	{
-		if (l % nhypo == 0)
-		{
-			m_obstaclesCollided += 1;
-		}
-	}
-	if (m_obstaclesCollided != 0 or m_goalIdxReached != 0)
-	{
-		m_isPathSuccess = false;
-	}
-
-}
 
-void AstarSolver_t::back_track_path()
-{
-	// start from the goal
-	AstarNode_t *current = m_closed[m_closed.size()-1];
-	while (current->m_id != m_start)
+	if (mu == infinity)
 	{
-		// keep backtracking the path until you reach the start
-		m_path.push_back(current->m_id);
-		current = current->m_parent;
+		std::cout << "The problem is not solvable. Search failed...\n";
+		m_isFailure = true;
+		return;
 	}
-	// finally put the start into the path
-	m_path.push_back(current->m_id);
-}
-
-void AstarSolver_t::print_path()
-{
-	// print the path for checking purpose
-	std::cout << "path: \n";
-	for (auto const &waypoint : m_path)
+	std::cout << "Goal is connected all the way to the start\n";
+	// m_path goes from the goal to the start: the backward half first, then the forward one
+	for (int n = meet[1]; n != -1; n = m_nodes[n].m_parent)
 	{
-		std::cout << waypoint << " ";
+		m_path.push_back(m_nodes[n].m_id);
 	}
-	std::cout << "\n";
-}
-
-void AstarSolver_t::printLabels()
-{
-	std::cout << "labels: " << "< ";
-	for (auto const &l : m_goalLabels)
+	std::reverse(m_path.begin(), m_path.end());
+	for (int n = m_nodes[meet[0]].m_parent; n != -1; n = m_nodes[n].m_parent)
 	{
-		std::cout << l << " ";
+		m_path.push_back(m_nodes[n].m_id);
 	}
-	std::cout << ">\n";
+	pathToTrajectory(g);
+	computeLabels(g);
+	m_goalIdxReached = m_goalTable->getTargetPose(m_path[0]);
+	m_pathCost = mu;
 }
 
-void AstarSolver_t::print_cost()
+float AstarSolver_t::potential(int node)
 {
-	std::cout << "cost: " << m_pathCost << "\n";
-}
-		
-void AstarSolver_t::print_goalIdxReached()
-{
-	std::cout << "The reaching target pose is: " << m_goalIdxReached << "\n";
-}
-
-void AstarSolver_t::printAll()
-{
-	print_path();
-	print_cost();
-	printLabels();
-	print_goalIdxReached();
-}
-
-void AstarSolver_t::pathToTrajectory(Graph_t &g)
-{
-	// start from the start
-	for (int i=m_path.size()-1; i >=0; i--)
+	float hf = m_H[node];
+	float hb = m_HBack[node];
+	// the node is on no path from the start to a goal
+	if (hf == std::numeric_limits<float>::infinity() or hb == std::numeric_limits<float>::infinity())
 	{
-		m_trajectory.push_back(g.getState(m_path[i]));
-
+		return std::numeric_limits<float>::infinity();
 	}
-	// // print the trajectory for checking purpose
-	// std::cout << "The trajectory: \n";
-	// for (auto const &t : m_trajectory)
-	// {
-	// 	for (auto const &d : t)
-	// 	{
-	// 		std::cout << d << "   ";
-	// 	}
-	// 	std::cout << "\n";
-	// }
+	return 0.5*(hf - hb);
 }
 
-void AstarSolver_t::writeTrajectory(std::string trajectory_file)
+void AstarSolver_t::relax(const Graph_t &g, const AstarNode_t *current, int currentIdx, int neighbor, int e)
 {
-	m_outFile_.open(trajectory_file);
-	if (m_outFile_.is_open())
+	float edgeCost = g.getEdgeCostById(e);
+	// check if the neighbor node has been visited or extended before
+	if ( m_expanded[neighbor] ) {return;}
+	if ( m_G[neighbor] > m_G[current->m_id] + edgeCost )
 	{
-		for (auto const &t : m_trajectory)
-		{
-			for (auto const &d : t)
-			{
-				m_outFile_ << d << " ";
-			}
-			m_outFile_ << "\n";
-		}
+		m_G.at(neighbor) = m_G[current->m_id] + edgeCost;
+		m_open.push(neighbor, m_nodes.create(neighbor, m_H[neighbor], 
+											m_G[neighbor]+m_H[neighbor], currentIdx));
 	}
-	m_outFile_.close();
-
 }
 
-void AstarSolver_t::computeLabels(Graph_t &g)
+void AstarSolver_t::computeLabels(const Graph_t &g)
 {
-	std::vector<int> temp_edgelabels;
+	ConstRange_t<int> temp_edgelabels;
 	for (int i = 0; i < m_path.size()-1; i++)
 	{
 		temp_edgelabels = g.getEdgeLabels(m_path[i], m_path[i+1]);
 		m_goalLabels = label_union(m_goalLabels, temp_edgelabels);
 	}	
 }
-
-
-std::vector<int> AstarSolver_t::label_union(std::vector<int> s1, std::vector<int> s2)
-{
-	// sort the sets first before applying union operation
-	std::sort(s1.begin(), s1.end());
-	std::sort(s2.begin(), s2.end());
-
-	// Declaring resultant vector for union
-	std::vector<int> v(s1.size()+s2.size());
-	// using function set_union() to compute union of 2
-	// containers v1 and v2 and store result in v
-	auto it = std::set_union(s1.begin(), s1.end(), s2.begin(), s2.end(), v.begin());
-
-	// resizing new container
-	v.resize(it - v.begin());
-	return v;
-}
\ No newline at end of file
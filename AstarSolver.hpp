@@ -10,6 +10,9 @@ with specified start and goal */
 #include <fstream>
 
 #include "Graph.hpp"
+#include "SearchCore.hpp"
+#include "Heuristic.hpp"
+#include "StampedArray.hpp"
 
 
 struct AstarNode_t
@@ -17,8 +20,12 @@ struct AstarNode_t
 	int m_id;
 	float m_h;
 	float m_f;
-	AstarNode_t *m_parent;
-	AstarNode_t(int id, float h, float f, AstarNode_t *p)
+	int m_parent; // index of the parent in the node pool, -1 for the start
+	// the priority key, kept in the open list
+	struct Key_t { float m_f; float m_h; };
+	Key_t key() const { return Key_t{m_f, m_h}; }
+
+	AstarNode_t(int id, float h, float f, int p)
 	{
 		m_id = id;
 		m_h = h;
@@ -29,7 +36,9 @@ struct AstarNode_t
 
 struct AstarNode_comparison
 {
-	bool operator()(const AstarNode_t* a, const AstarNode_t* b)
+	// compares nodes or their keys
+	template <typename T>
+	bool operator()(const T* a, const T* b)
 	{
 		if (a->m_f == b->m_f)
 		{
@@ -40,61 +49,55 @@ struct AstarNode_comparison
 };
 
 
-class AstarSolver_t
+class AstarSolver_t : public SearchCore_t<AstarSolver_t, AstarNode_t, AstarNode_comparison,
+							IndexedOpenList_t<AstarNode_t, AstarNode_comparison>>
 {
-	std::vector<int> m_path;
-	std::vector<std::vector<float>> m_trajectory;
+	friend class SearchCore_t<AstarSolver_t, AstarNode_t, AstarNode_comparison, IndexedOpenList_t<AstarNode_t, AstarNode_comparison>>;
 
-	std::priority_queue<AstarNode_t*, std::vector<AstarNode_t*>, AstarNode_comparison> m_open;
-	std::vector<AstarNode_t*> m_closed;
-	std::vector<bool> m_expanded;
+	StampedSet_t m_expanded;
 	
-	std::vector<float> m_G;
-	std::vector<float> m_H;
-	int m_start;
-	std::vector<int> m_goalSet;
-	std::vector<int> m_targetPoses;
-	std::map<int, int> m_goalmap;
-
-	std::ofstream m_outFile_;
-	bool m_isFailure;
-
-	std::vector<int> m_goalLabels;
-	int m_goalIdxReached;
-	int m_obstaclesCollided;
-	bool m_isPathSuccess;
-	float m_pathCost;
-
+	StampedArray_t<float> m_G;
+	HeuristicMode_t m_heuristic;
+	GoalHeuristic_t m_H;
+
+	// bidirectional search only: the backward side and, in both directions, the
+	// pool index of the best node of every graph node
+	IndexedOpenList_t<AstarNode_t, AstarNode_comparison> m_openBack;
+	StampedSet_t m_expandedBack;
+	StampedArray_t<float> m_GBack;
+	GoalTable_t m_startTable;
+	GoalHeuristic_t m_HBack;
+	StampedArray_t<int> m_bestNode[2];
+	// the forward potential of a node, half the forward h minus the backward h (the
+	// backward potential is its opposite). Infinity if the node is on no path
+	float potential(int node);
+
+	// search policies (see SearchCore.hpp)
+	bool isDominated(const AstarNode_t *n) { return m_expanded[n->m_id]; }
+	void close(const AstarNode_t *n) { m_expanded.insert(n->m_id); }
+	void relax(const Graph_t &g, const AstarNode_t *current, int currentIdx, int neighbor, int e);
+	void harvest(const Graph_t &g, const AstarNode_t *) { computeLabels(g); }
 
 public:
-	AstarSolver_t(Graph_t &g, int start, std::vector<int> goalSet);
-	~AstarSolver_t();
-
-	void computeH(Graph_t &g);
-	void Astar_search(Graph_t &g);
-	void back_track_path();
-	void pathToTrajectory(Graph_t &g);
-	void writeTrajectory(std::string trajectory_file);
-	void computeLabels(Graph_t &g);
-	void printLabels();
-	void print_path();
-	void print_cost();
-	void print_goalIdxReached();
-	void printAll();
-
-	std::vector<int> label_union(std::vector<int> s1, std::vector<int> s2);
-
-
-	// harvest the results
-	void checkPathSuccess(int nhypo);
-
-	// getters
-	std::vector<std::vector<float>> getTrajectory() {return m_trajectory;}
-	bool getFailureIndicator() {return m_isFailure;}
-	int getObstaclesCollided() {return m_obstaclesCollided;}
-	bool getIsPathSuccess() {return m_isPathSuccess;}
-	float getPathCost() {return m_pathCost;}
-
+	// heuristic: which h to use (see Heuristic.hpp)
+	AstarSolver_t(const Graph_t &g, int start, std::vector<int> goalSet, 
+										HeuristicMode_t heuristic = HEURISTIC_GOALMEAN);
+	// start over with another query on the same graph and heuristic mode, reusing the
+	// buffers: costs the previous search, not the size of the graph
+	void reset(const Graph_t &g, int start, std::vector<int> goalSet);
+
+	void computeH(const Graph_t &g, HeuristicMode_t heuristic = HEURISTIC_GOALMEAN);
+	void Astar_search(const Graph_t &g);
+	// bidirectional A*: forward from the start and backward from all the goals at once
+	// (a virtual goal linked to every goal at no cost), with the same kind of heuristic
+	// to the start backward (the lazy goal mean for the goal mean). Both sides use the
+	// average of the two heuristics, so it stops once the lowest f of the two sides add
+	// up to the best meeting so far. With a consistent heuristic (landmarks) it returns
+	// the same path cost as Astar_search, in fewer expansions as the path gets longer;
+	// with the goal mean it expands about as many nodes. The cost-to-go is exact, so
+	// that mode runs Astar_search
+	void AstarBidirectional_search(const Graph_t &g);
+	void computeLabels(const Graph_t &g);
 };
 
 
@@ -0,0 +1,72 @@
+/* This hpp file declares a light-weight read-only view over a
+contiguous block of elements owned by someone else (e.g. the graph) */
+
+#ifndef CONSTRANGE_H
+#define CONSTRANGE_H
+
+#include <cstddef>
+#include <vector>
+#include <iterator>
+
+template <typename T>
+class ConstRange_t
+{
+	const T *m_begin;
+	const T *m_end;
+
+public:
+	// Constructor
+	ConstRange_t() : m_begin(nullptr), m_end(nullptr) {}
+	ConstRange_t(const T *begin, const T *end) : m_begin(begin), m_end(end) {}
+	ConstRange_t(const std::vector<T> &v) : m_begin(v.data()), m_end(v.data()+v.size()) {}
+
+	const T* begin() const { return m_begin; }
+	const T* end() const { return m_end; }
+	const T* data() const { return m_begin; }
+	std::size_t size() const { return m_end - m_begin; }
+	bool empty() const { return m_begin == m_end; }
+	const T& operator[](std::size_t i) const { return m_begin[i]; }
+};
+
+// a read-only view over elements which are a fixed stride apart
+// (e.g. one node state in a structure-of-arrays buffer)
+template <typename T>
+class StridedRange_t
+{
+	const T *m_first;
+	std::size_t m_size;
+	std::size_t m_stride;
+
+public:
+	class const_iterator
+	{
+		const T *m_p;
+		std::size_t m_stride;
+	public:
+		typedef std::forward_iterator_tag iterator_category;
+		typedef T value_type;
+		typedef std::ptrdiff_t difference_type;
+		typedef const T* pointer;
+		typedef const T& reference;
+
+		const_iterator(const T *p, std::size_t stride) : m_p(p), m_stride(stride) {}
+		const T& operator*() const { return *m_p; }
+		const_iterator& operator++() { m_p += m_stride; return *this; }
+		const_iterator operator++(int) { const_iterator it = *this; m_p += m_stride; return it; }
+		bool operator==(const const_iterator &o) const { return m_p == o.m_p; }
+		bool operator!=(const const_iterator &o) const { return m_p != o.m_p; }
+	};
+
+	// Constructor
+	StridedRange_t() : m_first(nullptr), m_size(0), m_stride(1) {}
+	StridedRange_t(const T *first, std::size_t size, std::size_t stride) 
+		: m_first(first), m_size(size), m_stride(stride) {}
+
+	const_iterator begin() const { return const_iterator(m_first, m_stride); }
+	const_iterator end() const { return const_iterator(m_first + m_size*m_stride, m_stride); }
+	std::size_t size() const { return m_size; }
+	bool empty() const { return m_size == 0; }
+	const T& operator[](std::size_t i) const { return m_first[i*m_stride]; }
+};
+
+#endif
@@ -0,0 +1,58 @@
+/* This hpp file declares a flat array which either owns its elements
+or borrows them from memory owned by someone else (e.g. a mapped file) */
+
+#ifndef FLATARRAY_H
+#define FLATARRAY_H
+
+#include <cstddef>
+#include <vector>
+#include <memory>
+
+template <typename T, typename Allocator = std::allocator<T>>
+class FlatArray_t
+{
+	std::vector<T, Allocator> m_owned;
+	// non-null when the elements are borrowed
+	const T *m_borrowed;
+	std::size_t m_borrowedSize;
+
+public:
+	// Constructor
+	FlatArray_t() : m_borrowed(nullptr), m_borrowedSize(0) {}
+
+	// take over the elements of a vector
+	void assign(std::vector<T, Allocator> v)
+	{
+		m_owned = std::move(v);
+		m_borrowed = nullptr;
+		m_borrowedSize = 0;
+	}
+	// refer to n elements at data, which must outlive the array
+	void borrow(const T *data, std::size_t n)
+	{
+		m_owned = std::vector<T, Allocator>();
+		m_borrowed = data;
+		m_borrowedSize = n;
+	}
+	// writable access: borrowed elements are copied into owned memory first
+	std::vector<T, Allocator>& edit()
+	{
+		if (m_borrowed != nullptr)
+		{
+			m_owned.assign(m_borrowed, m_borrowed+m_borrowedSize);
+			m_borrowed = nullptr;
+			m_borrowedSize = 0;
+		}
+		return m_owned;
+	}
+
+	bool isBorrowed() const { return m_borrowed != nullptr; }
+	const T* data() const { return (m_borrowed != nullptr) ? m_borrowed : m_owned.data(); }
+	std::size_t size() const { return (m_borrowed != nullptr) ? m_borrowedSize : m_owned.size(); }
+	bool empty() const { return size() == 0; }
+	const T* begin() const { return data(); }
+	const T* end() const { return data()+size(); }
+	const T& operator[](std::size_t i) const { return data()[i]; }
+};
+
+#endif
@@ -0,0 +1,33 @@
+/* This cpp file defines a dense goal lookup table: for every node of
+the graph, whether it is a goal and which target pose it belongs to */
+
+#include "GoalTable.hpp"
+
+GoalTable_t::GoalTable_t(int nNodes, const std::vector<int> &goalSet, 
+												const std::vector<int> &targetPoses)
+{
+	build(nNodes, goalSet, targetPoses);
+}
+
+void GoalTable_t::build(int nNodes, const std::vector<int> &goalSet, 
+												const std::vector<int> &targetPoses)
+{
+	if (m_goalSlots.size() == nNodes)
+	{
+		for (auto const &goal : m_goalSet) { m_goalSlots[goal] = -1; }
+	}
+	else
+	{
+		m_goalSlots.assign(nNodes, -1);
+	}
+	m_goalSet = goalSet;
+	m_targetPoses.assign(goalSet.size(), -1);
+	for (int i=0; i < goalSet.size(); i++)
+	{
+		m_goalSlots[goalSet[i]] = i;
+		if (i < targetPoses.size())
+		{
+			m_targetPoses[i] = targetPoses[i];
+		}
+	}
+}
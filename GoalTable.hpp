@@ -0,0 +1,41 @@
+/* This hpp file declares a dense goal lookup table: for every node of
+the graph, whether it is a goal and which target pose it belongs to, so
+that the solvers test goals in constant time */
+
+#ifndef GOALTABLE_H
+#define GOALTABLE_H
+
+#include <vector>
+
+class GoalTable_t
+{
+	// position of every node in the goal set, -1 if it is not a goal
+	// (a node listed several times keeps its last position)
+	std::vector<int> m_goalSlots;
+	// target pose of every position of the goal set
+	std::vector<int> m_targetPoses;
+	// the goal set, so that a rebuild only clears the slots of the old goals
+	std::vector<int> m_goalSet;
+
+public:
+	// Constructor
+	GoalTable_t() {}
+	GoalTable_t(int nNodes, const std::vector<int> &goalSet, const std::vector<int> &targetPoses);
+
+	// goalSet[i] aims at targetPoses[i]. Building again for the same number of
+	// nodes costs the old and the new goals, not the nodes
+	void build(int nNodes, const std::vector<int> &goalSet, const std::vector<int> &targetPoses);
+
+	// getters
+	bool isGoal(int id) const { return m_goalSlots[id] != -1; }
+	// the position of a goal in the goal set (-1 if id is not a goal)
+	int getGoalSlot(int id) const { return m_goalSlots[id]; }
+	// the target pose a goal aims at
+	int getTargetPose(int id) const { return m_targetPoses[m_goalSlots[id]]; }
+	int getnGoals() const { return m_targetPoses.size(); }
+
+	// Destructor
+	~GoalTable_t() {}
+};
+
+#endif
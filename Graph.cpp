@@ -4,19 +4,25 @@ from the roadmap built in robotic scenarios.*/
 #include <vector>
 #include <fstream>
 #include <iostream>
-#include <sstream>
 #include <limits>
 #include <typeinfo>
+#include <algorithm>
+#include <cstring>
+#include <cmath>
+#include <thread>
+#include <queue>
+#include <functional>
 // #include <cstdlib>
 
 #include "Graph.hpp"
+#include "RoadmapBundle.hpp"
+#include "ParallelTextReader.hpp"
 
 Graph_t::Graph_t(std::string samples_file, std::string roadmap_file, 
 				std::string labelWeight_file, std::string mostPromisingLabels_file, int nsamples)
 {
+	// m_nNodes is known after getting all the node states (samples)
 	specify_nodeStates(samples_file, nsamples);
-	// After getting all the node states (samples)
-	m_nNodes = m_nodeStates.size();
 	specify_neighborCostsAndLabels(roadmap_file);
 
 	specify_labelWeight(labelWeight_file);
@@ -26,183 +32,1099 @@ Graph_t::Graph_t(std::string samples_file, std::string roadmap_file,
 
 void Graph_t::specify_nodeStates(std::string samples_file, int nsamples)
 {
+	if (m_isFrozen)
+	{
+		std::cerr << "The graph is frozen, unable to load the samples\n";
+		exit(1); // call system to stop
+	}
+	clear_heuristics();
 	// read in the samples file
-	m_inFile_.open(samples_file);
-	std::string temp_str;
-	int temp_nodeIdx;
-	int temp_counter1 = 0;
-	float c;
+	ParallelTextReader_t reader;
 	// Check that the file was opened successfully
 	// std::cout << samples_file << "\n";
-	if (!m_inFile_)
+	if (!reader.open(samples_file))
 	{
 		std::cerr << "Unable to open the samples file\n";
 		exit(1); // call system to stop
 	}
-	while (std::getline(m_inFile_, temp_str))
+	// every chunk collects its lines: the node index, the number of values and the values
+	struct SampleLines_t
+	{
+		std::vector<int> m_nodeIdx;
+		std::vector<int> m_nvalues;
+		std::vector<float> m_values;
+	};
+	std::vector<SampleLines_t> chunks(reader.getnChunks());
+	reader.forEachChunk([&chunks](int chunk, const char *p, const char *end)
 	{
-		if (temp_counter1 <= nsamples)
+		SampleLines_t &lines = chunks[chunk];
+		int temp_nodeIdx;
+		float c;
+		while (p < end)
 		{
-			std::stringstream ss(temp_str);
-			ss >> temp_nodeIdx;
+			const char *lineEnd = find_lineEnd(p, end);
+			// lines without a node index (blank lines) are skipped
+			if (parse_nextInt(p, lineEnd, temp_nodeIdx))
+			{
+				int nvalues = 0;
+				while (parse_nextFloat(p, lineEnd, c))
+				{
+					lines.m_values.push_back(c);
+					nvalues++;
+				}
+				lines.m_nodeIdx.push_back(temp_nodeIdx);
+				lines.m_nvalues.push_back(nvalues);
+			}
+			p = lineEnd + 1;
+		}
+	});
+
+	// the first nsamples+1 lines are the samples (the last of them is the start),
+	// the remaining ones are goals with the index of their target pose at the end
+	int temp_counter1 = 0;
+	m_nDims = -1;
+	std::vector<float> nodeStates;
+	for (auto const &lines : chunks)
+	{
+		const float *v = lines.m_values.data();
+		for (int ii=0; ii < lines.m_nodeIdx.size(); ii++)
+		{
+			int temp_nodeIdx = lines.m_nodeIdx[ii];
+			int nvalues = lines.m_nvalues[ii];
+			int ndims = nvalues;
 			if (temp_counter1 == nsamples)
 			{
 				m_start = temp_nodeIdx;
 			}
-			std::vector<float> temp_v;
-			while (ss >> c)
+			if (temp_counter1 > nsamples) // it is a goal
+			{
+				if (nvalues == 0)
+				{
+					std::cerr << "Goal " << temp_nodeIdx << " does not have a target pose\n";
+					exit(1); // call system to stop
+				}
+				ndims = nvalues - 1;
+				m_goalSet.push_back(temp_nodeIdx);
+				m_targetPoses.push_back(v[ndims]);
+			}
+			// all the states share one dimension, given by the first sample
+			if (m_nDims == -1)
+			{
+				m_nDims = ndims;
+				nodeStates.reserve(std::size_t(m_nDims) * 
+								(lines.m_values.size() / std::max(nvalues, 1)) * chunks.size());
+			}
+			if (ndims != m_nDims)
 			{
-				temp_v.push_back(c);
+				std::cerr << "Sample " << temp_nodeIdx << " does not have " << m_nDims << " dimensions\n";
+				exit(1); // call system to stop
 			}
-			m_nodeStates.push_back(temp_v);			
+			nodeStates.insert(nodeStates.end(), v, v+ndims);
+			v += nvalues;
+			temp_counter1++;
 		}
-		else // else they are goals
+	}
+	m_nNodes = temp_counter1;
+	// transpose the rows into the structure-of-arrays buffer (the padding is zeroed)
+	m_stateStride = nodeStates_stride(m_nNodes);
+	std::vector<float, AlignedAllocator_t<float, NODE_STATES_ALIGNMENT>> soaStates(
+													std::max(m_nDims, 0) * m_stateStride, 0.0);
+	for (int i=0; i < m_nNodes; i++)
+	{
+		for (int j=0; j < m_nDims; j++)
+		{
+			soaStates[j*m_stateStride + i] = nodeStates[std::size_t(i)*m_nDims + j];
+		}
+	}
+	m_nodeStates.assign(std::move(soaStates));
+	build_goalTable();
+}
+
+void Graph_t::build_goalTable()
+{
+	for (auto const &goal : m_goalSet)
+	{
+		if (goal < 0 or goal >= m_nNodes)
 		{
-			std::stringstream ss(temp_str);
-			ss >> temp_nodeIdx;
-			m_goalSet.push_back(temp_nodeIdx);
-			std::vector<float> temp_v;
-			// a more general way to extract node state
-			while (ss >> c)
+			std::cerr << "Goal " << goal << " is not a node of the graph\n";
+			exit(1); // call system to stop
+		}
+	}
+	m_goalTable.build(m_nNodes, m_goalSet, m_targetPoses);
+}
+
+// node ranges smaller than this are not worth a thread
+const int MIN_DISTANCE_CHUNK = 1 << 17;
+
+void Graph_t::computeSquaredDistances(const float *point, float *out, int nthreads) const
+{
+	if (nthreads <= 0)
+	{
+		nthreads = std::max(1u, std::thread::hardware_concurrency());
+	}
+	int nchunks = std::max(1, std::min(nthreads, m_nNodes / MIN_DISTANCE_CHUNK));
+	if (nchunks == 1)
+	{
+		compute_squaredDistances(point, 0, m_nNodes, out);
+		return;
+	}
+	// every chunk starts on a cache line of each dimension
+	int chunkSize = nodeStates_stride((m_nNodes + nchunks-1) / nchunks);
+	std::vector<std::thread> workers;
+	for (int begin=0; begin < m_nNodes; begin += chunkSize)
+	{
+		int end = std::min(begin + chunkSize, m_nNodes);
+		workers.push_back(std::thread(&Graph_t::compute_squaredDistances, this, point, begin, end, out));
+	}
+	for (auto &w : workers) { w.join(); }
+}
+
+void Graph_t::compute_squaredDistances(const float *point, int begin, int end, float *out) const
+{
+	switch (m_nDims)
+	{
+		case 7:
+			NodeStates_t<7>(m_nodeStates.data(), m_stateStride, 7).squaredDistances(point, begin, end, out);
+			break;
+		case 6:
+			NodeStates_t<6>(m_nodeStates.data(), m_stateStride, 6).squaredDistances(point, begin, end, out);
+			break;
+		case 3:
+			NodeStates_t<3>(m_nodeStates.data(), m_stateStride, 3).squaredDistances(point, begin, end, out);
+			break;
+		case 2:
+			NodeStates_t<2>(m_nodeStates.data(), m_stateStride, 2).squaredDistances(point, begin, end, out);
+			break;
+		default:
+			getNodeStates().squaredDistances(point, begin, end, out);
+	}
+}
+
+
+std::vector<float> Graph_t::getGoalMean(const std::vector<int> &goalSet) const
+{
+	std::vector<float> goal_mean = std::vector<float>(m_nDims, 0.0);
+	for (auto const &goal : goalSet)
+	{
+		StridedRange_t<float> v_goal = getState(goal);
+		for (int j=0; j < v_goal.size(); j++)
+		{
+			goal_mean[j] = goal_mean[j] + v_goal[j];
+		}
+	}
+	for (int j=0; j < goal_mean.size(); j++)
+	{
+		goal_mean[j] = goal_mean[j] / goalSet.size();
+	}
+	return goal_mean;
+}
+
+void Graph_t::compute_goalMeanHeuristic(const std::vector<int> &goalSet, std::vector<float> &H) const
+{
+	std::vector<float> goal_mean = getGoalMean(goalSet);
+
+	// compute euclidean distance of all the nodes at once, goals get 0.0
+	H = std::vector<float>(m_nNodes);
+	computeSquaredDistances(goal_mean.data(), H.data());
+	for (int i=0; i < m_nNodes; i++)
+	{
+		H[i] = sqrt(H[i]);
+	}
+	for (auto const &goal : goalSet)
+	{
+		H[goal] = 0.0;
+	}
+}
+
+std::shared_ptr<const std::vector<float>> Graph_t::getGoalMeanHeuristic(const std::vector<int> &goalSet) const
+{
+	{
+		std::lock_guard<std::mutex> lock(m_heuristicsMutex);
+		auto it = m_heuristics.find(goalSet);
+		if (it != m_heuristics.end()) { return it->second; }
+	}
+	// computed without the lock so that queries on other goal sets are not held up,
+	// if two queries compute the same table the first one stored is kept
+	std::shared_ptr<std::vector<float>> H = std::make_shared<std::vector<float>>();
+	compute_goalMeanHeuristic(goalSet, *H);
+	std::lock_guard<std::mutex> lock(m_heuristicsMutex);
+	return m_heuristics.emplace(goalSet, H).first->second;
+}
+
+std::shared_ptr<const std::vector<float>> Graph_t::findGoalMeanHeuristic(const std::vector<int> &goalSet) const
+{
+	std::lock_guard<std::mutex> lock(m_heuristicsMutex);
+	auto it = m_heuristics.find(goalSet);
+	return (it != m_heuristics.end()) ? it->second : nullptr;
+}
+
+void Graph_t::clear_heuristics()
+{
+	std::lock_guard<std::mutex> lock(m_heuristicsMutex);
+	m_heuristics.clear();
+}
+
+void Graph_t::compute_shortestDistances(int source, float *dist) const
+{
+	compute_shortestDistances(std::vector<int>(1, source), dist);
+}
+
+void Graph_t::compute_shortestDistances(const std::vector<int> &sources, float *dist) const
+{
+	std::fill(dist, dist+m_nNodes, std::numeric_limits<float>::infinity());
+	// (cost, node), the cheapest first, settled nodes are skipped when popped again
+	typedef std::pair<float, int> Entry_t;
+	std::priority_queue<Entry_t, std::vector<Entry_t>, std::greater<Entry_t>> open;
+	for (auto const &source : sources)
+	{
+		dist[source] = 0.0;
+		open.push(Entry_t(0.0, source));
+	}
+	while (!open.empty())
+	{
+		Entry_t current = open.top();
+		open.pop();
+		if (current.first > dist[current.second]) { continue; }
+		ConstRange_t<int> neighbors = getNodeNeighbors(current.second);
+		ConstRange_t<int> edges = getNodeEdges(current.second);
+		for (int k=0; k < neighbors.size(); k++)
+		{
+			float temp_g = current.first + m_edgeCosts[edges[k]];
+			if (temp_g < dist[neighbors[k]])
 			{
-				temp_v.push_back(c);
+				dist[neighbors[k]] = temp_g;
+				open.push(Entry_t(temp_g, neighbors[k]));
 			}
-			m_targetPoses.push_back(temp_v[temp_v.size()-1]);
-			temp_v.pop_back();
-			// int temp_counter2 = 0;
-			// while (ss >> c)
-			// {	
-			// 	if (temp_counter2 < 7)
-			// 	{
-			// 		temp_v.push_back(c);
-			// 	}
-			// 	else // the index of the target poses
-			// 	{
-			// 		m_targetPoses.push_back(c);
-			// 	}
-			// 	temp_counter2++;
-			// }
-			m_nodeStates.push_back(temp_v);
 		}
+	}
+}
 
-		temp_counter1++;
+bool Graph_t::computeLandmarks(int nLandmarks)
+{
+	if (m_isFrozen) { return false; }
+	nLandmarks = std::min(nLandmarks, m_nNodes);
+	std::vector<int> landmarks;
+	std::vector<float> distances(std::size_t(nLandmarks)*m_nNodes);
+	if (nLandmarks > 0)
+	{
+		// the first landmark is the node farthest from the start (or from node 0), every
+		// next one the node farthest from all the landmarks so far (among the reachable ones)
+		std::vector<float> temp_dist(m_nNodes);
+		compute_shortestDistances((m_start >= 0 and m_start < m_nNodes) ? m_start : 0, temp_dist.data());
+		std::vector<float> closest = temp_dist;
+		for (int l=0; l < nLandmarks; l++)
+		{
+			int farthest = -1;
+			for (int i=0; i < m_nNodes; i++)
+			{
+				if (closest[i] != std::numeric_limits<float>::infinity() and 
+					(farthest == -1 or closest[i] > closest[farthest]))
+				{
+					farthest = i;
+				}
+			}
+			if (farthest == -1 or (l > 0 and closest[farthest] == 0.0)) { break; }
+			float *dist = distances.data() + landmarks.size()*m_nNodes;
+			compute_shortestDistances(farthest, dist);
+			landmarks.push_back(farthest);
+			for (int i=0; i < m_nNodes; i++)
+			{
+				closest[i] = (l == 0) ? dist[i] : std::min(closest[i], dist[i]);
+			}
+		}
+	}
+	distances.resize(landmarks.size()*m_nNodes);
+	m_landmarks.assign(landmarks);
+	m_landmarkDistances.assign(distances);
+	return true;
+}
 
+void Graph_t::clear_landmarks()
+{
+	m_landmarks.assign(std::vector<int>());
+	m_landmarkDistances.assign(std::vector<float>());
+}
+
+std::shared_ptr<const std::vector<float>> Graph_t::getCostToGo(const std::vector<int> &goalSet) const
+{
+	{
+		std::lock_guard<std::mutex> lock(m_heuristicsMutex);
+		auto it = m_costsToGo.find(goalSet);
+		if (it != m_costsToGo.end()) { return it->second; }
 	}
-	// while (!m_inFile_.eof())
-	// {
-	// 	m_inFile_ >> temp_nodeIdx >> temp_j1 >> temp_j2 >> temp_j3 >> temp_j4 
-	// 			>> temp_j5 >> temp_j6 >> temp_j7;
-	// 	m_nodeStates.push_back(std::vector<float>{temp_j1, temp_j2, temp_j3, 
-	// 									temp_j4, temp_j5, temp_j6, temp_j7});
-	// }
+	// as in getGoalMeanHeuristic, computed without the lock and the first one stored is kept
+	std::shared_ptr<std::vector<float>> costs = std::make_shared<std::vector<float>>(m_nNodes);
+	compute_shortestDistances(goalSet, costs->data());
+	std::lock_guard<std::mutex> lock(m_heuristicsMutex);
+	return m_costsToGo.emplace(goalSet, costs).first->second;
+}
+
+void Graph_t::clear_costsToGo()
+{
+	std::lock_guard<std::mutex> lock(m_heuristicsMutex);
+	m_costsToGo.clear();
+}
 
-	m_inFile_.close();
+std::uint64_t Graph_t::compute_edgesFingerprint() const
+{
+	// FNV-1a over the degree, the neighbors and the edge costs of every row
+	std::uint64_t h = 14695981039346656037ull;
+	auto add = [&h](std::uint32_t v) {
+		for (int b=0; b < 4; b++)
+		{
+			h ^= (v >> (8*b)) & 0xff;
+			h *= 1099511628211ull;
+		}
+	};
+	add(m_nNodes);
+	for (int i=0; i < m_nNodes; i++)
+	{
+		ConstRange_t<int> neighbors = getNodeNeighbors(i);
+		ConstRange_t<int> edges = getNodeEdges(i);
+		add(neighbors.size());
+		for (int k=0; k < neighbors.size(); k++)
+		{
+			std::uint32_t cost;
+			std::memcpy(&cost, &m_edgeCosts[edges[k]], sizeof(cost));
+			add(neighbors[k]);
+			add(cost);
+		}
+	}
+	return h;
+}
+
+void Graph_t::write_costToGo(std::string file, const std::vector<int> &goalSet) const
+{
+	std::shared_ptr<const std::vector<float>> costs = getCostToGo(goalSet);
+	CostToGoHeader_t header;
+	std::memset(&header, 0, sizeof(header));
+	std::memcpy(header.m_magic, COST_TO_GO_MAGIC, sizeof(header.m_magic));
+	header.m_version = COST_TO_GO_VERSION;
+	header.m_byteOrder = ROADMAP_BUNDLE_BYTE_ORDER;
+	header.m_nNodes = m_nNodes;
+	header.m_nGoals = goalSet.size();
+	header.m_edgesFingerprint = compute_edgesFingerprint();
+
+	std::ofstream outFile(file, std::ios::binary);
+	if (!outFile)
+	{
+		std::cerr << "Unable to open the cost-to-go file for writing\n";
+		exit(1);
+	}
+	outFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	outFile.write(reinterpret_cast<const char*>(goalSet.data()), sizeof(int)*goalSet.size());
+	outFile.write(reinterpret_cast<const char*>(costs->data()), sizeof(float)*costs->size());
+	if (!outFile)
+	{
+		std::cerr << "Failed to write the cost-to-go file\n";
+		exit(1);
+	}
+}
+
+bool Graph_t::load_costToGo(std::string file) const
+{
+	std::ifstream inFile(file, std::ios::binary);
+	CostToGoHeader_t header;
+	if (!inFile.read(reinterpret_cast<char*>(&header), sizeof(header)) or 
+		std::memcmp(header.m_magic, COST_TO_GO_MAGIC, sizeof(header.m_magic)) != 0 or 
+		header.m_version != COST_TO_GO_VERSION or header.m_byteOrder != ROADMAP_BUNDLE_BYTE_ORDER or 
+		header.m_nNodes != m_nNodes or header.m_nGoals < 0 or 
+		header.m_edgesFingerprint != compute_edgesFingerprint())
+	{
+		return false;
+	}
+	std::vector<int> goalSet(header.m_nGoals);
+	std::shared_ptr<std::vector<float>> costs = std::make_shared<std::vector<float>>(m_nNodes);
+	if (!inFile.read(reinterpret_cast<char*>(goalSet.data()), sizeof(int)*goalSet.size()) or 
+		!inFile.read(reinterpret_cast<char*>(costs->data()), sizeof(float)*costs->size()))
+	{
+		return false;
+	}
+	std::lock_guard<std::mutex> lock(m_heuristicsMutex);
+	m_costsToGo[goalSet] = costs;
+	return true;
 }
 
 
 void Graph_t::specify_mostPromisingLabels(std::string mostPromisingLabels_file)
 {
-	m_inFile_.open(mostPromisingLabels_file);
+	if (m_isFrozen)
+	{
+		std::cerr << "The graph is frozen, unable to load the most promising labels\n";
+		exit(1); // call system to stop
+	}
+	ParallelTextReader_t reader;
 	// std::cout << mostPromisingLabels_file << "\n";
-	if (!m_inFile_)
+	if (!reader.open(mostPromisingLabels_file, 1))
 	{
 		std::cerr << "Unable to open the mostPromisingLabels file\n";
 		exit(1); // call system to stop
 	}
-	std::string temp_str;
-	int c;
-	while (std::getline(m_inFile_, temp_str))
+	reader.forEachChunk([this](int, const char *p, const char *end)
 	{
-		std::stringstream ss(temp_str);
-		while (ss >> c)
+		int c;
+		while (p < end)
 		{
-			m_mostPromisingLabels.push_back(c);
+			const char *lineEnd = find_lineEnd(p, end);
+			while (parse_nextInt(p, lineEnd, c))
+			{
+				m_mostPromisingLabels.push_back(c);
+			}
+			p = lineEnd + 1;
 		}
-	}
+	});
 }
 
 
 void Graph_t::specify_neighborCostsAndLabels(std::string roadmap_file)
 {
-	int iter = 0;
-	// create empty neighbors and cost vector for each node
-	while (iter != m_nNodes)
+	if (m_isFrozen)
 	{
-		m_nodeNeighbors.push_back(std::vector<int>());
-		m_edgeLabels.push_back(std::vector<std::vector<int>>(m_nNodes,
-			 std::vector<int>()));
-		m_edgeCosts.push_back(std::vector<float>(m_nNodes, std::numeric_limits<float>::max()));
-		iter++;
+		std::cerr << "The graph is frozen, unable to load the roadmap\n";
+		exit(1); // call system to stop
 	}
-
+	clear_landmarks();
+	clear_costsToGo();
 	// read in the roadmap
 	// std::cout << roadmap_file << "\n";
-	m_inFile_.open(roadmap_file);
-	std::string temp_str;
-	int temp_n1;
-	int temp_n2;
-	float temp_cost;
-	int c;
+	ParallelTextReader_t reader;
 	// Check that the file was opened successfully
-	if (!m_inFile_)
+	if (!reader.open(roadmap_file))
 	{
 		std::cerr << "Unable to open the roadmap file\n";
 		exit(1); // call system to stop
 	}
-	while (std::getline(m_inFile_, temp_str))
+	// every chunk collects its edges: both nodes, the cost and the labels
+	struct EdgeLines_t
+	{
+		std::vector<int> m_edgeNodes;
+		std::vector<float> m_costs;
+		std::vector<int> m_nlabels;
+		std::vector<int> m_labels;
+		bool m_isValid = true;
+	};
+	std::vector<EdgeLines_t> chunks(reader.getnChunks());
+	int nNodes = m_nNodes;
+	reader.forEachChunk([&chunks, nNodes](int chunk, const char *p, const char *end)
 	{
-		std::stringstream ss(temp_str);
-		ss >> temp_n1 >> temp_n2 >> temp_cost;
-		m_nodeNeighbors[temp_n1].push_back(temp_n2);
-		m_nodeNeighbors[temp_n2].push_back(temp_n1);
-		m_edgeCosts[temp_n1][temp_n2] = temp_cost;
-		m_edgeCosts[temp_n2][temp_n1] = temp_cost;
-		while (ss >> c)
+		EdgeLines_t &lines = chunks[chunk];
+		int temp_n1;
+		int temp_n2;
+		float temp_cost;
+		int c;
+		while (p < end)
 		{
-			m_edgeLabels[temp_n1][temp_n2].push_back(c);
-			m_edgeLabels[temp_n2][temp_n1].push_back(c);
+			const char *lineEnd = find_lineEnd(p, end);
+			// lines without an edge (blank lines) are skipped
+			if (parse_nextInt(p, lineEnd, temp_n1) and parse_nextInt(p, lineEnd, temp_n2) and 
+				parse_nextFloat(p, lineEnd, temp_cost))
+			{
+				if (temp_n1 < 0 or temp_n1 >= nNodes or temp_n2 < 0 or temp_n2 >= nNodes)
+				{
+					lines.m_isValid = false;
+				}
+				lines.m_edgeNodes.push_back(temp_n1);
+				lines.m_edgeNodes.push_back(temp_n2);
+				lines.m_costs.push_back(temp_cost);
+				int nlabels = 0;
+				while (parse_nextInt(p, lineEnd, c))
+				{
+					lines.m_labels.push_back(c);
+					nlabels++;
+				}
+				lines.m_nlabels.push_back(nlabels);
+			}
+			p = lineEnd + 1;
+		}
+	});
 
+	// edge list in the order of the roadmap file
+	std::vector<int> temp_edgeNodes;
+	std::vector<float> edgeCosts;
+	std::vector<int> edgeLabelSets;
+	std::vector<int> temp_labels;
+	m_labelSetOffsets.assign(std::vector<int>(1, 0));
+	internLabelSet(temp_labels); // the empty set gets id 0
+	for (auto const &lines : chunks)
+	{
+		if (!lines.m_isValid)
+		{
+			std::cerr << "The roadmap file refers to a node which is not in the samples file\n";
+			exit(1); // call system to stop
+		}
+		temp_edgeNodes.insert(temp_edgeNodes.end(), lines.m_edgeNodes.begin(), lines.m_edgeNodes.end());
+		edgeCosts.insert(edgeCosts.end(), lines.m_costs.begin(), lines.m_costs.end());
+		const int *l = lines.m_labels.data();
+		for (auto const &nlabels : lines.m_nlabels)
+		{
+			temp_labels.assign(l, l+nlabels);
+			edgeLabelSets.push_back(internLabelSet(temp_labels));
+			l += nlabels;
 		}
 	}
-	// while (!m_inFile_.eof())
-	// {
-	// 	m_inFile_ >> temp_n1 >> temp_n2 >> temp_cost;
-	// 	m_nodeNeighbors[temp_n1].push_back(temp_n2);
-	// 	m_nodeNeighbors[temp_n2].push_back(temp_n1);
-	// 	m_edgeCosts[temp_n1][temp_n2] = temp_cost;
-	// 	m_edgeCosts[temp_n2][temp_n1] = temp_cost;
-	// }
+	m_nEdges = edgeCosts.size();
+
+	// count the degree of each node and turn it into row offsets
+	std::vector<int> adjOffsets(m_nNodes+1, 0);
+	for (auto const &n : temp_edgeNodes)
+	{
+		adjOffsets[n+1]++;
+	}
+	for (int i=0; i < m_nNodes; i++)
+	{
+		adjOffsets[i+1] += adjOffsets[i];
+	}
+	// fill each row in the order the edges appear in the file so that
+	// the neighbors keep the same order as they are read in
+	std::vector<int> temp_cursor(adjOffsets.begin(), adjOffsets.end()-1);
+	std::vector<int> adjNodes(temp_edgeNodes.size());
+	std::vector<int> adjEdges(temp_edgeNodes.size());
+	int temp_n1;
+	int temp_n2;
+	for (int e=0; e < m_nEdges; e++)
+	{
+		temp_n1 = temp_edgeNodes[2*e];
+		temp_n2 = temp_edgeNodes[2*e+1];
+		adjNodes[temp_cursor[temp_n1]] = temp_n2;
+		adjEdges[temp_cursor[temp_n1]++] = e;
+		adjNodes[temp_cursor[temp_n2]] = temp_n1;
+		adjEdges[temp_cursor[temp_n2]++] = e;
+	}
+	std::vector<int> adjDegrees(m_nNodes);
+	for (int i=0; i < m_nNodes; i++)
+	{
+		adjDegrees[i] = adjOffsets[i+1] - adjOffsets[i];
+	}
+	adjOffsets.pop_back();
+	m_adjOffsets.assign(std::move(adjOffsets));
+	m_adjDegrees.assign(std::move(adjDegrees));
+	m_adjCapacities.clear();
+	m_adjNodes.assign(std::move(adjNodes));
+	m_adjEdges.assign(std::move(adjEdges));
+	m_edgeCosts.assign(std::move(edgeCosts));
+	m_edgeLabelSets.assign(std::move(edgeLabelSets));
+}
 
-	m_inFile_.close();
+static std::size_t hash_labelSet(const int *begin, const int *end)
+{
+	std::size_t h = end - begin;
+	for (const int *l = begin; l != end; l++)
+	{
+		h ^= std::hash<int>()(*l) + 0x9e3779b9 + (h << 6) + (h >> 2);
+	}
+	return h;
+}
+
+void Graph_t::build_labelSetIndex()
+{
+	m_labelSetIndex.clear();
+	for (int s=0; s < getnLabelSets(); s++)
+	{
+		ConstRange_t<int> labels = getLabelSet(s);
+		m_labelSetIndex.emplace(hash_labelSet(labels.begin(), labels.end()), s);
+	}
+}
+
+int Graph_t::internLabelSet(std::vector<int> &labels)
+{
+	// label sets are kept sorted so that identical sets share one entry
+	std::sort(labels.begin(), labels.end());
+	// the index is not stored in a roadmap bundle
+	if (m_labelSetIndex.size() != getnLabelSets())
+	{
+		build_labelSetIndex();
+	}
+	std::size_t h = hash_labelSet(labels.data(), labels.data()+labels.size());
+	auto range = m_labelSetIndex.equal_range(h);
+	for (auto it = range.first; it != range.second; it++)
+	{
+		int s = it->second;
+		if (m_labelSetOffsets[s+1]-m_labelSetOffsets[s] == labels.size() and 
+			std::equal(labels.begin(), labels.end(), m_labelArena.data()+m_labelSetOffsets[s]))
+		{
+			return s;
+		}
+	}
+	// a new label set, append it to the arena
+	int s = m_labelSetOffsets.size()-1;
+	std::vector<int> &arena = m_labelArena.edit();
+	arena.insert(arena.end(), labels.begin(), labels.end());
+	m_labelSetOffsets.edit().push_back(arena.size());
+	m_labelSetIndex.emplace(h, s);
+	return s;
+}
+
+int Graph_t::findEdge(int id1, int id2) const
+{
+	if (id1 < 0 or id1 >= m_nNodes or id2 < 0 or id2 >= m_nNodes or id1 == id2)
+	{
+		return -1;
+	}
+	// scan the shorter of the two rows
+	if (m_adjDegrees[id1] > m_adjDegrees[id2])
+	{
+		std::swap(id1, id2);
+	}
+	for (int k=m_adjOffsets[id1]; k < m_adjOffsets[id1]+m_adjDegrees[id1]; k++)
+	{
+		if (m_adjNodes[k] == id2) { return m_adjEdges[k]; }
+	}
+	return -1;
+}
+
+void Graph_t::insert_neighbor(int id, int neighbor, int e)
+{
+	std::vector<int> &offsets = m_adjOffsets.edit();
+	std::vector<int> &degrees = m_adjDegrees.edit();
+	std::vector<int> &adjNodes = m_adjNodes.edit();
+	std::vector<int> &adjEdges = m_adjEdges.edit();
+	if (m_adjCapacities.empty())
+	{
+		m_adjCapacities.assign(degrees.begin(), degrees.end());
+	}
+	if (degrees[id] == m_adjCapacities[id])
+	{
+		// the row is full: move it to the end of the arrays with twice the room
+		// (its old entries are left unused)
+		int capacity = std::max(2*degrees[id], 4);
+		int begin = adjNodes.size();
+		adjNodes.resize(begin + capacity, -1);
+		adjEdges.resize(begin + capacity, -1);
+		std::copy(adjNodes.begin()+offsets[id], adjNodes.begin()+offsets[id]+degrees[id], 
+																		adjNodes.begin()+begin);
+		std::copy(adjEdges.begin()+offsets[id], adjEdges.begin()+offsets[id]+degrees[id], 
+																		adjEdges.begin()+begin);
+		offsets[id] = begin;
+		m_adjCapacities[id] = capacity;
+	}
+	adjNodes[offsets[id]+degrees[id]] = neighbor;
+	adjEdges[offsets[id]+degrees[id]] = e;
+	degrees[id]++;
+}
+
+void Graph_t::erase_neighbor(int id, int neighbor)
+{
+	std::vector<int> &degrees = m_adjDegrees.edit();
+	std::vector<int> &adjNodes = m_adjNodes.edit();
+	std::vector<int> &adjEdges = m_adjEdges.edit();
+	int begin = m_adjOffsets[id];
+	int end = begin + degrees[id];
+	for (int k=begin; k < end; k++)
+	{
+		if (adjNodes[k] == neighbor)
+		{
+			// shift the rest of the row so that the neighbors keep their order
+			std::copy(adjNodes.begin()+k+1, adjNodes.begin()+end, adjNodes.begin()+k);
+			std::copy(adjEdges.begin()+k+1, adjEdges.begin()+end, adjEdges.begin()+k);
+			degrees[id]--;
+			return;
+		}
+	}
+}
+
+int Graph_t::addEdge(int id1, int id2, float cost, std::vector<int> labels)
+{
+	if (m_isFrozen or id1 < 0 or id1 >= m_nNodes or id2 < 0 or id2 >= m_nNodes or id1 == id2 or 
+		findEdge(id1, id2) != -1)
+	{
+		return -1;
+	}
+	int e = m_edgeCosts.size();
+	m_edgeCosts.edit().push_back(cost);
+	m_edgeLabelSets.edit().push_back(internLabelSet(labels));
+	insert_neighbor(id1, id2, e);
+	insert_neighbor(id2, id1, e);
+	m_nEdges++;
+	clear_landmarks();
+	clear_costsToGo();
+	return e;
+}
+
+bool Graph_t::removeEdge(int id1, int id2)
+{
+	int e = findEdge(id1, id2);
+	if (e == -1 or m_isFrozen) { return false; }
+	erase_neighbor(id1, id2);
+	erase_neighbor(id2, id1);
+	m_nEdges--;
+	clear_landmarks();
+	clear_costsToGo();
+	return true;
+}
+
+bool Graph_t::setEdgeCost(int id1, int id2, float cost)
+{
+	int e = findEdge(id1, id2);
+	if (e == -1 or m_isFrozen) { return false; }
+	m_edgeCosts.edit()[e] = cost;
+	clear_landmarks();
+	clear_costsToGo();
+	return true;
+}
+
+bool Graph_t::addEdgeLabel(int id1, int id2, int label)
+{
+	int e = findEdge(id1, id2);
+	if (e == -1 or m_isFrozen) { return false; }
+	ConstRange_t<int> labels = getEdgeLabelsById(e);
+	if (std::binary_search(labels.begin(), labels.end(), label)) { return true; }
+	std::vector<int> temp_labels(labels.begin(), labels.end());
+	temp_labels.push_back(label);
+	m_edgeLabelSets.edit()[e] = internLabelSet(temp_labels);
+	return true;
+}
+
+bool Graph_t::removeEdgeLabel(int id1, int id2, int label)
+{
+	int e = findEdge(id1, id2);
+	if (e == -1 or m_isFrozen) { return false; }
+	ConstRange_t<int> labels = getEdgeLabelsById(e);
+	if (!std::binary_search(labels.begin(), labels.end(), label)) { return true; }
+	std::vector<int> temp_labels;
+	for (auto const &l : labels)
+	{
+		if (l != label) { temp_labels.push_back(l); }
+	}
+	m_edgeLabelSets.edit()[e] = internLabelSet(temp_labels);
+	return true;
+}
+
+float Graph_t::getEdgeCost(int id1, int id2) const
+{
+	int e = findEdge(id1, id2);
+	if (e == -1) { return std::numeric_limits<float>::max(); }
+	return m_edgeCosts[e];
+}
+
+ConstRange_t<int> Graph_t::getEdgeLabels(int id1, int id2) const
+{
+	int e = findEdge(id1, id2);
+	if (e == -1) { return getLabelSet(0); }
+	return getEdgeLabelsById(e);
 }
 
 void Graph_t::specify_labelWeight(std::string labelWeight_file)
 {
+	if (m_isFrozen)
+	{
+		std::cerr << "The graph is frozen, unable to load the label weights\n";
+		exit(1); // call system to stop
+	}
 	// read the label weight
-	m_inFile_.open(labelWeight_file);
+	ParallelTextReader_t reader;
 	// std::cout << labelWeight_file << "\n";
-	std::string temp_str;
-	int temp_labelIdx;
-	int temp_objIdx;
-	float temp_weight;
 	// Check that the file was opened successfully
-	if (!m_inFile_)
+	if (!reader.open(labelWeight_file, 1))
 	{
 		std::cerr << "Unable to open the label weight file\n";
 		exit(1); // call system to stop
 	}
-	while (std::getline(m_inFile_, temp_str))
+	reader.forEachChunk([this](int, const char *p, const char *end)
 	{
-		std::stringstream ss(temp_str);
-		ss >> temp_labelIdx >> temp_objIdx >> temp_weight;
-		m_labelWeights[temp_labelIdx] = std::pair<int, float>(temp_objIdx, temp_weight);
+		int temp_labelIdx;
+		int temp_objIdx;
+		float temp_weight;
+		while (p < end)
+		{
+			const char *lineEnd = find_lineEnd(p, end);
+			if (parse_nextInt(p, lineEnd, temp_labelIdx) and parse_nextInt(p, lineEnd, temp_objIdx) 
+				and parse_nextFloat(p, lineEnd, temp_weight))
+			{
+				m_labelWeights[temp_labelIdx] = std::pair<int, float>(temp_objIdx, temp_weight);
+			}
+			p = lineEnd + 1;
+		}
+	});
+	build_labelWeightTable();
+}
+
+void Graph_t::build_labelWeightTable()
+{
+	// dense copy of the weights for the search, indexed by label
+	m_singleWeights.clear();
+	m_labelObstacles.clear();
+	for (auto const &lw : m_labelWeights)
+	{
+		if (lw.first < 0 or lw.second.first < 0)
+		{
+			std::cerr << "Label " << lw.first << " (obstacle " << lw.second.first 
+						<< ") has a negative id in the label weights\n";
+			exit(1); // call system to stop
+		}
+	}
+	if (!m_labelWeights.empty())
+	{
+		int nlabels = m_labelWeights.rbegin()->first + 1;
+		m_singleWeights = std::vector<float>(nlabels, 0.0);
+		m_labelObstacles = std::vector<int>(nlabels, 0);
+		for (auto const &lw : m_labelWeights)
+		{
+			m_labelObstacles[lw.first] = lw.second.first;
+			m_singleWeights[lw.first] = lw.second.second;
+		}
+	}
+	m_nObstacles = 0;
+	for (auto const &obs : m_labelObstacles)
+	{
+		m_nObstacles = std::max(m_nObstacles, obs+1);
+	}
+	m_labelWeightsVersion++;
+}
+
+bool Graph_t::setLabelWeight(int label, int obstacle, float weight)
+{
+	// the dense table only holds non-negative labels
+	if (m_isFrozen or label < 0 or obstacle < 0)
+	{
+		return false;
+	}
+	m_labelWeights[label] = std::pair<int, float>(obstacle, weight);
+	if (label >= m_singleWeights.size())
+	{
+		m_singleWeights.resize(label+1, 0.0);
+		m_labelObstacles.resize(label+1, 0);
+		m_nObstacles = std::max(m_nObstacles, 1);
+	}
+	int old_obstacle = m_labelObstacles[label];
+	m_labelObstacles[label] = obstacle;
+	m_singleWeights[label] = weight;
+	if (obstacle+1 >= m_nObstacles)
+	{
+		m_nObstacles = obstacle+1;
+	}
+	else if (old_obstacle+1 == m_nObstacles)
+	{
+		// the highest obstacle may be gone
+		m_nObstacles = 0;
+		for (auto const &obs : m_labelObstacles)
+		{
+			m_nObstacles = std::max(m_nObstacles, obs+1);
+		}
+	}
+	m_labelWeightsVersion++;
+	return true;
+}
+
+Graph_t::Graph_t(std::string bundle_file)
+{
+	load_binaryRoadmap(bundle_file);
+}
+
+void Graph_t::load_binaryRoadmap(std::string bundle_file)
+{
+	if (m_isFrozen)
+	{
+		std::cerr << "The graph is frozen, unable to load the roadmap bundle\n";
+		exit(1); // call system to stop
+	}
+	clear_heuristics();
+	clear_costsToGo();
+	if (!m_bundle.open(bundle_file))
+	{
+		std::cerr << "Unable to open the roadmap bundle file\n";
+		exit(1); // call system to stop
+	}
+	RoadmapBundleHeader_t header;
+	if (m_bundle.size() < sizeof(header))
+	{
+		std::cerr << "The roadmap bundle file is truncated\n";
+		exit(1);
+	}
+	std::memcpy(&header, m_bundle.data(), sizeof(header));
+	if (std::memcmp(header.m_magic, ROADMAP_BUNDLE_MAGIC, sizeof(header.m_magic)) != 0 or 
+		header.m_byteOrder != ROADMAP_BUNDLE_BYTE_ORDER)
+	{
+		std::cerr << "The file is not a roadmap bundle (or has another byte order)\n";
+		exit(1);
+	}
+	if (header.m_version != ROADMAP_BUNDLE_VERSION)
+	{
+		std::cerr << "Unsupported roadmap bundle version " << header.m_version 
+					<< " (expected " << ROADMAP_BUNDLE_VERSION << ")\n";
+		exit(1);
+	}
+	// every section has to lie inside the file, aligned
+	for (int sec=0; sec < RMB_NSECTIONS; sec++)
+	{
+		const RoadmapBundleSectionEntry_t &entry = header.m_sections[sec];
+		if (entry.m_offset % ROADMAP_BUNDLE_ALIGNMENT != 0 or entry.m_offset > m_bundle.size() or 
+			entry.m_count > (m_bundle.size() - entry.m_offset) / 4)
+		{
+			std::cerr << "The roadmap bundle file is corrupted (section " << sec << ")\n";
+			exit(1);
+		}
+	}
+	m_nNodes = header.m_nNodes;
+	m_nDims = header.m_nDims;
+	m_stateStride = nodeStates_stride(m_nNodes);
+	m_nEdges = header.m_nEdges;
+	m_start = header.m_start;
+	const RoadmapBundleSectionEntry_t *sections = header.m_sections;
+	if (sections[RMB_ADJ_OFFSETS].m_count != m_nNodes or 
+		sections[RMB_ADJ_DEGREES].m_count != m_nNodes or 
+		sections[RMB_ADJ_NODES].m_count < 2*std::uint64_t(m_nEdges) or 
+		sections[RMB_ADJ_EDGES].m_count != sections[RMB_ADJ_NODES].m_count or 
+		sections[RMB_EDGE_COSTS].m_count < m_nEdges or 
+		sections[RMB_EDGE_LABEL_SETS].m_count != sections[RMB_EDGE_COSTS].m_count or 
+		sections[RMB_LABEL_SET_OFFSETS].m_count < 1 or 
+		m_nNodes < 0 or m_nDims < 0 or 
+		sections[RMB_NODE_STATES].m_count != m_stateStride*m_nDims or 
+		sections[RMB_TARGET_POSES].m_count != sections[RMB_GOAL_SET].m_count or 
+		sections[RMB_LABEL_OBSTACLES].m_count != sections[RMB_LABEL_IDS].m_count or 
+		sections[RMB_LABEL_WEIGHTS].m_count != sections[RMB_LABEL_IDS].m_count or 
+		sections[RMB_LANDMARK_DISTANCES].m_count != sections[RMB_LANDMARKS].m_count*m_nNodes)
+	{
+		std::cerr << "The roadmap bundle file is inconsistent\n";
+		exit(1);
+	}
+	const char *base = m_bundle.data();
+	auto ints = [&](int sec) { return reinterpret_cast<const int*>(base + sections[sec].m_offset); };
+	auto floats = [&](int sec) { return reinterpret_cast<const float*>(base + sections[sec].m_offset); };
+
+	// every index the arrays hold has to point inside the graph, the queries do not check
+	// them (one pass over the arrays)
+	std::uint64_t nAdjEntries = sections[RMB_ADJ_NODES].m_count;
+	std::uint64_t nEdgeIds = sections[RMB_EDGE_COSTS].m_count;
+	std::uint64_t nLabelSets = sections[RMB_LABEL_SET_OFFSETS].m_count - 1;
+	bool isValid = (m_start >= 0 and m_start < m_nNodes);
+	for (int i=0; isValid and i < m_nNodes; i++)
+	{
+		int offset = ints(RMB_ADJ_OFFSETS)[i];
+		int degree = ints(RMB_ADJ_DEGREES)[i];
+		isValid = (offset >= 0 and degree >= 0 and std::uint64_t(offset) + degree <= nAdjEntries);
+		for (int k=0; isValid and k < degree; k++)
+		{
+			int neighbor = ints(RMB_ADJ_NODES)[offset+k];
+			int e = ints(RMB_ADJ_EDGES)[offset+k];
+			isValid = (neighbor >= 0 and neighbor < m_nNodes and e >= 0 and std::uint64_t(e) < nEdgeIds);
+		}
+	}
+	for (std::uint64_t e=0; isValid and e < nEdgeIds; e++)
+	{
+		int s = ints(RMB_EDGE_LABEL_SETS)[e];
+		isValid = (s >= 0 and std::uint64_t(s) < nLabelSets);
+	}
+	const int *labelSetOffsets = ints(RMB_LABEL_SET_OFFSETS);
+	isValid = isValid and labelSetOffsets[0] >= 0 and 
+					std::uint64_t(labelSetOffsets[nLabelSets]) <= sections[RMB_LABEL_ARENA].m_count;
+	for (std::uint64_t s=0; isValid and s < nLabelSets; s++)
+	{
+		isValid = (labelSetOffsets[s] <= labelSetOffsets[s+1]);
+	}
+	for (std::uint64_t i=0; isValid and i < sections[RMB_GOAL_SET].m_count; i++)
+	{
+		isValid = (ints(RMB_GOAL_SET)[i] >= 0 and ints(RMB_GOAL_SET)[i] < m_nNodes);
+	}
+	for (std::uint64_t l=0; isValid and l < sections[RMB_LANDMARKS].m_count; l++)
+	{
+		isValid = (ints(RMB_LANDMARKS)[l] >= 0 and ints(RMB_LANDMARKS)[l] < m_nNodes);
+	}
+	if (!isValid)
+	{
+		std::cerr << "The roadmap bundle file is corrupted (an index is out of range)\n";
+		exit(1);
+	}
+
+	// the large arrays are used in place
+	m_adjOffsets.borrow(ints(RMB_ADJ_OFFSETS), sections[RMB_ADJ_OFFSETS].m_count);
+	m_adjDegrees.borrow(ints(RMB_ADJ_DEGREES), sections[RMB_ADJ_DEGREES].m_count);
+	m_adjCapacities.clear();
+	m_adjNodes.borrow(ints(RMB_ADJ_NODES), sections[RMB_ADJ_NODES].m_count);
+	m_adjEdges.borrow(ints(RMB_ADJ_EDGES), sections[RMB_ADJ_EDGES].m_count);
+	m_edgeCosts.borrow(floats(RMB_EDGE_COSTS), sections[RMB_EDGE_COSTS].m_count);
+	m_edgeLabelSets.borrow(ints(RMB_EDGE_LABEL_SETS), sections[RMB_EDGE_LABEL_SETS].m_count);
+	m_labelSetOffsets.borrow(ints(RMB_LABEL_SET_OFFSETS), sections[RMB_LABEL_SET_OFFSETS].m_count);
+	m_labelArena.borrow(ints(RMB_LABEL_ARENA), sections[RMB_LABEL_ARENA].m_count);
+	m_nodeStates.borrow(floats(RMB_NODE_STATES), sections[RMB_NODE_STATES].m_count);
+	m_landmarks.borrow(ints(RMB_LANDMARKS), sections[RMB_LANDMARKS].m_count);
+	m_landmarkDistances.borrow(floats(RMB_LANDMARK_DISTANCES), sections[RMB_LANDMARK_DISTANCES].m_count);
+	m_labelSetIndex.clear();
+
+	// the small ones are copied
+	m_goalSet.assign(ints(RMB_GOAL_SET), ints(RMB_GOAL_SET) + sections[RMB_GOAL_SET].m_count);
+	m_targetPoses.assign(ints(RMB_TARGET_POSES), 
+							ints(RMB_TARGET_POSES) + sections[RMB_TARGET_POSES].m_count);
+	m_mostPromisingLabels.assign(ints(RMB_MOST_PROMISING_LABELS), 
+			ints(RMB_MOST_PROMISING_LABELS) + sections[RMB_MOST_PROMISING_LABELS].m_count);
+	build_goalTable();
+	m_labelWeights.clear();
+	for (int ii=0; ii < sections[RMB_LABEL_IDS].m_count; ii++)
+	{
+		m_labelWeights[ints(RMB_LABEL_IDS)[ii]] = 
+			std::pair<int, float>(ints(RMB_LABEL_OBSTACLES)[ii], floats(RMB_LABEL_WEIGHTS)[ii]);
+	}
+	build_labelWeightTable();
+}
+
+void Graph_t::write_binaryRoadmap(std::string bundle_file) const
+{
+	std::vector<int> labelIds;
+	std::vector<int> labelObstacles;
+	std::vector<float> labelWeights;
+	for (auto const &lw : m_labelWeights)
+	{
+		labelIds.push_back(lw.first);
+		labelObstacles.push_back(lw.second.first);
+		labelWeights.push_back(lw.second.second);
+	}
+	// the content of every section in RoadmapBundleSection_t order (all elements are 4 bytes)
+	std::vector<std::pair<const void*, std::uint64_t>> content = {
+		{m_adjOffsets.data(), m_adjOffsets.size()}, 
+		{m_adjDegrees.data(), m_adjDegrees.size()}, 
+		{m_adjNodes.data(), m_adjNodes.size()}, 
+		{m_adjEdges.data(), m_adjEdges.size()}, 
+		{m_edgeCosts.data(), m_edgeCosts.size()}, 
+		{m_edgeLabelSets.data(), m_edgeLabelSets.size()}, 
+		{m_labelSetOffsets.data(), m_labelSetOffsets.size()}, 
+		{m_labelArena.data(), m_labelArena.size()}, 
+		{m_nodeStates.data(), m_nodeStates.size()}, 
+		{m_goalSet.data(), m_goalSet.size()}, 
+		{m_targetPoses.data(), m_targetPoses.size()}, 
+		{labelIds.data(), labelIds.size()}, 
+		{labelObstacles.data(), labelObstacles.size()}, 
+		{labelWeights.data(), labelWeights.size()}, 
+		{m_mostPromisingLabels.data(), m_mostPromisingLabels.size()}, 
+		{m_landmarks.data(), m_landmarks.size()}, 
+		{m_landmarkDistances.data(), m_landmarkDistances.size()}};
+
+	RoadmapBundleHeader_t header;
+	std::memset(&header, 0, sizeof(header));
+	std::memcpy(header.m_magic, ROADMAP_BUNDLE_MAGIC, sizeof(header.m_magic));
+	header.m_version = ROADMAP_BUNDLE_VERSION;
+	header.m_byteOrder = ROADMAP_BUNDLE_BYTE_ORDER;
+	header.m_nNodes = m_nNodes;
+	header.m_nDims = m_nDims;
+	header.m_nEdges = m_nEdges;
+	header.m_start = m_start;
+	std::uint64_t offset = sizeof(header);
+	for (int sec=0; sec < RMB_NSECTIONS; sec++)
+	{
+		offset = (offset + ROADMAP_BUNDLE_ALIGNMENT-1) / ROADMAP_BUNDLE_ALIGNMENT * ROADMAP_BUNDLE_ALIGNMENT;
+		header.m_sections[sec].m_offset = offset;
+		header.m_sections[sec].m_count = content[sec].second;
+		offset += 4*content[sec].second;
+	}
+
+	std::ofstream outFile(bundle_file, std::ios::binary);
+	if (!outFile)
+	{
+		std::cerr << "Unable to open the roadmap bundle file for writing\n";
+		exit(1);
+	}
+	outFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	std::uint64_t written = sizeof(header);
+	const char padding[ROADMAP_BUNDLE_ALIGNMENT] = {};
+	for (int sec=0; sec < RMB_NSECTIONS; sec++)
+	{
+		outFile.write(padding, header.m_sections[sec].m_offset - written);
+		outFile.write(static_cast<const char*>(content[sec].first), 4*content[sec].second);
+		written = header.m_sections[sec].m_offset + 4*content[sec].second;
+	}
+	if (!outFile)
+	{
+		std::cerr << "Failed to write the roadmap bundle file\n";
+		exit(1);
 	}
-	// while (!m_inFile_.eof())
-	// {
-	// 	m_inFile_ >> temp_labelIdx >> temp_objIdx >> temp_weight;
-	// 	m_labelWeights[temp_labelIdx] = std::pair<int, float>(temp_objIdx, temp_weight);
-	// }
-	m_inFile_.close();
 }
 
 void Graph_t::print_graph()
@@ -225,41 +1147,20 @@ void Graph_t::print_graph()
 	// }
 	// // std::cout << "\n\n\n";
 
-	// // print the m_nodeNeighbors
+	// // print the neighbors, edge costs and edge labels (CSR rows)
 	// std::cout << "_________node neighbors_________\n";
-	// for (auto const &nbs : m_nodeNeighbors)
-	// {
-	// 	for (auto const &nb : nbs)
-	// 	{
-	// 		std::cout << nb << " ";
-	// 	}
-	// 	std::cout << "\n";
-	// }
-	// // std::cout << "\n\n\n";
-
-	// // print the m_edgeCosts
-	// std::cout << "_________edge cost_________\n";
-	// for (auto const &costs : m_edgeCosts)
-	// {
-	// 	for (auto const &c : costs)
-	// 	{
-	// 		std::cout << c << "\t";
-	// 	}
-	// 	std::cout << "\n";
-	// }
-	// // std::cout << "\n\n\n";
-
-	// // print the m_edgeLabels
-	// std::cout << "_________edge labels_________\n";
-	// for (auto const &edges : m_edgeLabels)
+	// for (int i=0; i < m_nNodes; i++)
 	// {
-	// 	for (auto const &e : edges)
+	// 	for (int k=m_adjOffsets[i]; k < m_adjOffsets[i]+m_adjDegrees[i]; k++)
 	// 	{
-	// 		for (auto const &l : e)
+	// 		int e = m_adjEdges[k];
+	// 		int s = m_edgeLabelSets[e];
+	// 		std::cout << m_adjNodes[k] << "(" << m_edgeCosts[e] << ": ";
+	// 		for (int l=m_labelSetOffsets[s]; l < m_labelSetOffsets[s+1]; l++)
 	// 		{
-	// 			std::cout << l << ",";
+	// 			std::cout << m_labelArena[l] << ",";
 	// 		}
-	// 		std::cout << "\t";
+	// 		std::cout << ") ";
 	// 	}
 	// 	std::cout << "\n";
 	// }
@@ -8,38 +8,126 @@ from the roadmap built in robotic scenarios.*/
 #include <string> // std::string, std::to_string
 #include <fstream>
 #include <map>
+#include <unordered_map>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+#include "ConstRange.hpp"
+#include "FlatArray.hpp"
+#include "AlignedAllocator.hpp"
+#include "NodeStates.hpp"
+#include "MappedFile.hpp"
+#include "GoalTable.hpp"
 
 class Graph_t
 {
 	// the size of the graph
 	int m_nNodes;
 
-	// specify neighbors(edges) and edge cost of the graph
-	std::vector<std::vector<int>> m_nodeNeighbors;
-	std::vector<std::vector<float>> m_edgeCosts;
-	std::vector<std::vector<float>> m_nodeStates;
+	// specify neighbors(edges) of the graph in compressed sparse row (CSR) form:
+	// the neighbors of node i are m_adjNodes[m_adjOffsets[i]] ... m_adjNodes[m_adjOffsets[i]+m_adjDegrees[i]-1]
+	// and m_adjEdges holds the undirected edge each of these entries refers to
+	FlatArray_t<int> m_adjOffsets;
+	FlatArray_t<int> m_adjDegrees;
+	FlatArray_t<int> m_adjNodes;
+	FlatArray_t<int> m_adjEdges;
+	// room reserved for each row after an incremental update (empty: rows are packed)
+	std::vector<int> m_adjCapacities;
+	// edge cost and label set id, stored once per undirected edge id
+	// (the ids of removed edges are not reused, m_nEdges counts the remaining ones)
+	int m_nEdges;
+	FlatArray_t<float> m_edgeCosts;
+	FlatArray_t<int> m_edgeLabelSets;
+	// interned label sets: every distinct (sorted) edge label set is kept once in
+	// m_labelArena, set s spans m_labelArena[m_labelSetOffsets[s]] ... [m_labelSetOffsets[s+1]-1]
+	// set 0 is always the empty set
+	FlatArray_t<int> m_labelSetOffsets;
+	FlatArray_t<int> m_labelArena;
+	// hash of a label set -> ids of the sets with that hash
+	std::unordered_multimap<std::size_t, int> m_labelSetIndex;
+	// node states in structure-of-arrays form (see NodeStates.hpp): dimension j of
+	// node i is m_nodeStates[j*m_stateStride + i]
+	int m_nDims;
+	std::size_t m_stateStride;
+	FlatArray_t<float, AlignedAllocator_t<float, NODE_STATES_ALIGNMENT>> m_nodeStates;
 	// specify the weight for each label (labeled graph)
 	std::map<int, std::pair<int, float>> m_labelWeights;
-	std::vector<std::vector<std::vector<int>>> m_edgeLabels;
+	// the same weights indexed directly by label for constant time lookup
+	std::vector<float> m_singleWeights;
+	std::vector<int> m_labelObstacles;
+	// number of obstacles (the highest obstacle index + 1)
+	int m_nObstacles;
+	// bumped on every change of the label weights, so that anything computed
+	// from them can tell whether it is still current
+	std::uint64_t m_labelWeightsVersion = 0;
 
 	// start and goal set
 	int m_start;
 	// goal set 
 	std::vector<int> m_goalSet;
 	std::vector<int> m_targetPoses;
+	// constant time goal tests for the goal set above
+	GoalTable_t m_goalTable;
 
-	// samples and roadmap reader
-	std::ifstream m_inFile_;
+	// a binary roadmap bundle the flat arrays above borrow their elements from
+	MappedFile_t m_bundle;
 
 	// most promising labels
 	std::vector<int> m_mostPromisingLabels;
 
+	// ALT landmarks (see computeLandmarks): the landmark nodes and, landmark by landmark,
+	// the shortest path cost from the landmark to every node (infinity if unreachable)
+	FlatArray_t<int> m_landmarks;
+	FlatArray_t<float> m_landmarkDistances;
+
+	// goal mean heuristic tables already computed, by goal set (see getGoalMeanHeuristic).
+	// They only depend on the node states, the edge and label updates keep them
+	mutable std::mutex m_heuristicsMutex;
+	mutable std::map<std::vector<int>, std::shared_ptr<const std::vector<float>>> m_heuristics;
+	// exact cost-to-go tables already computed or loaded, by goal set (see getCostToGo),
+	// also guarded by m_heuristicsMutex. The edge updates drop them
+	mutable std::map<std::vector<int>, std::shared_ptr<const std::vector<float>>> m_costsToGo;
+
+	// a frozen graph refuses every update, so that it can be shared read-only
+	// by queries running in parallel
+	bool m_isFrozen = false;
+
+	// add/remove one entry of the row of a node
+	void insert_neighbor(int id, int neighbor, int e);
+	void erase_neighbor(int id, int neighbor);
+	// (re)build m_labelSetIndex from the arena, e.g. after loading a roadmap bundle
+	void build_labelSetIndex();
+	// return the id of a label set in the arena, adding it if it has not been seen.
+	// It may grow the arena, so only the loaders and the updates (which check
+	// m_isFrozen) call it
+	int internLabelSet(std::vector<int> &labels);
+	// computeSquaredDistances for the nodes [begin, end) only
+	void compute_squaredDistances(const float *point, int begin, int end, float *out) const;
+	// H[i] = euclidean distance between node i and the mean of goalSet, 0.0 at the goals
+	void compute_goalMeanHeuristic(const std::vector<int> &goalSet, std::vector<float> &H) const;
+	// drop the heuristic tables, e.g. when new node states are loaded
+	void clear_heuristics();
+	// dist[i] = shortest path cost from source to node i (Dijkstra over the edge costs)
+	void compute_shortestDistances(int source, float *dist) const;
+	// the same from the closest of several sources
+	void compute_shortestDistances(const std::vector<int> &sources, float *dist) const;
+	// drop the landmark tables, e.g. when the edges change
+	void clear_landmarks();
+	// drop the cost-to-go tables, e.g. when the edges change
+	void clear_costsToGo();
+	// a hash of the rows and of the edge costs, to tell whether a cost-to-go file
+	// was written for this graph
+	std::uint64_t compute_edgesFingerprint() const;
+
 
 public:
 	// Constructor
 	Graph_t() {}
 	Graph_t(std::string samples_file, std::string roadmap_file, std::string labelWeight_file, 
 		std::string mostPromisingLabels_file, int nsamples);
+	// load a binary roadmap bundle (see RoadmapBundle.hpp)
+	Graph_t(std::string bundle_file);
 
 	// construct the graph
 	void specify_nodeStates(std::string samples_file, int nsamples);
@@ -47,19 +135,125 @@ public:
 	void specify_labelWeight(std::string labelWeight_file);
 	void specify_mostPromisingLabels(std::string mostPromisingLabels_file);
 	void print_graph();
+	// binary roadmap bundle: the loaded graph is used in place from the mapped file
+	void load_binaryRoadmap(std::string bundle_file);
+	void write_binaryRoadmap(std::string bundle_file) const;
+	// index the label weights by label (the label and obstacle ids must not be negative)
+	void build_labelWeightTable();
+	// index the goal set by node
+	void build_goalTable();
+	// update the weight (and obstacle) of one label between queries, the solvers
+	// read the weights from the graph so they see the update without being rebuilt
+	// (fails on a frozen graph)
+	bool setLabelWeight(int label, int obstacle, float weight);
+	// locate the undirected edge between two nodes (-1 if they are not connected or
+	// are not two distinct nodes of the graph)
+	int findEdge(int id1, int id2) const;
+	// after freeze() the graph is immutable: all the const methods may be called from
+	// several threads at once and the updates below fail. thaw() allows updates again
+	// and must only be called while no query is using the graph
+	void freeze() { m_isFrozen = true; }
+	void thaw() { m_isFrozen = false; }
+	bool isFrozen() const { return m_isFrozen; }
+	// incremental updates, each in amortized O(degree) time. Arrays borrowed from a
+	// roadmap bundle are copied on the first update. addEdge returns the id of the new
+	// edge (-1 if the nodes are invalid or already connected), the others return false
+	// if there is no edge between the two nodes (all fail on a frozen graph)
+	int addEdge(int id1, int id2, float cost, std::vector<int> labels);
+	bool removeEdge(int id1, int id2);
+	bool setEdgeCost(int id1, int id2, float cost);
+	bool addEdgeLabel(int id1, int id2, int label);
+	bool removeEdgeLabel(int id1, int id2, int label);
+	// out[i] = squared euclidean distance between node i and point for every node,
+	// with the kernel specialized for the number of dimensions of the graph. Large
+	// graphs are split across (at most) nthreads threads, 0 uses all the hardware threads
+	void computeSquaredDistances(const float *point, float *out, int nthreads = 0) const;
+	// H[i] = euclidean distance between node i and the mean of goalSet, 0.0 at the goals.
+	// The table is computed on the first call for a goal set and shared read-only by all
+	// the later ones (thread safe, also on a frozen graph)
+	std::shared_ptr<const std::vector<float>> getGoalMeanHeuristic(const std::vector<int> &goalSet) const;
+	// the same table if it has already been computed, nullptr otherwise
+	std::shared_ptr<const std::vector<float>> findGoalMeanHeuristic(const std::vector<int> &goalSet) const;
+	// the mean of the states of the nodes in goalSet
+	std::vector<float> getGoalMean(const std::vector<int> &goalSet) const;
+	// exact cost of the cheapest path from every node to the closest node of goalSet
+	// (infinity if there is none): one Dijkstra from all the goals at once, the edges
+	// being undirected. Computed on the first call for a goal set and shared read-only
+	// by the later ones (thread safe, also on a frozen graph). Any change of the edges
+	// or of their costs drops the tables
+	std::shared_ptr<const std::vector<float>> getCostToGo(const std::vector<int> &goalSet) const;
+	// the cost-to-go table of goalSet as a sidecar file next to the roadmap (see
+	// RoadmapBundle.hpp), so that another process can load it instead of computing it
+	void write_costToGo(std::string file, const std::vector<int> &goalSet) const;
+	// add the table of a sidecar file to the ones of getCostToGo. false if the file
+	// cannot be read or was written for other edges (then nothing is added)
+	bool load_costToGo(std::string file) const;
+
+	// ALT preprocessing: pick nLandmarks landmarks (each one the node farthest from the
+	// ones already picked) and store the shortest path costs from every landmark to every
+	// node with the graph. Any later change of the edges or of their costs drops them
+	// (fails on a frozen graph)
+	bool computeLandmarks(int nLandmarks);
 
 	// getters
-	int getnNodes() { return m_nNodes; }
-	std::vector<float> getState(int idx) { return m_nodeStates[idx]; }
-	int getStart() { return m_start; }
-	std::vector<int> getGoalSet() { return m_goalSet; }
-	std::vector<int> getTargetPoses() { return m_targetPoses; }
-	std::vector<int> getNodeNeighbors(int id) { return m_nodeNeighbors[id]; }
-	float getEdgeCost(int id1, int id2) { return m_edgeCosts[id1][id2]; }
-	std::vector<int> getEdgeLabels(int id1, int id2) { return m_edgeLabels[id1][id2]; }
-	std::map<int, std::pair<int, float>> getLabelWeights() { return m_labelWeights; }
-	float getSingleWeight(int l) { return m_labelWeights[l].second; }
-	std::vector<int> getMostPromisingLabels() { return m_mostPromisingLabels; }
+	// (the ranges and references returned point into the graph's own storage,
+	// they do not allocate and stay valid as long as the graph does)
+	int getnNodes() const { return m_nNodes; }
+	int getnEdges() const { return m_nEdges; }
+	int getnDims() const { return m_nDims; }
+	int getnLabelSets() const { return m_labelSetOffsets.size()-1; }
+	StridedRange_t<float> getState(int idx) const
+	{
+		return StridedRange_t<float>(m_nodeStates.data()+idx, m_nDims, m_stateStride);
+	}
+	NodeStates_t<0> getNodeStates() const
+	{
+		return NodeStates_t<0>(m_nodeStates.data(), m_stateStride, m_nDims);
+	}
+	int getStart() const { return m_start; }
+	const std::vector<int>& getGoalSet() const { return m_goalSet; }
+	const std::vector<int>& getTargetPoses() const { return m_targetPoses; }
+	const GoalTable_t& getGoalTable() const { return m_goalTable; }
+	// neighbors of a node and, entry by entry, the edges leading to them
+	ConstRange_t<int> getNodeNeighbors(int id) const
+	{
+		const int *row = m_adjNodes.data()+m_adjOffsets[id];
+		return ConstRange_t<int>(row, row+m_adjDegrees[id]);
+	}
+	ConstRange_t<int> getNodeEdges(int id) const
+	{
+		const int *row = m_adjEdges.data()+m_adjOffsets[id];
+		return ConstRange_t<int>(row, row+m_adjDegrees[id]);
+	}
+	float getEdgeCost(int id1, int id2) const;
+	ConstRange_t<int> getEdgeLabels(int id1, int id2) const;
+	// edge attributes by edge id (as returned by getNodeEdges)
+	float getEdgeCostById(int e) const { return m_edgeCosts[e]; }
+	ConstRange_t<int> getEdgeLabelsById(int e) const { return getLabelSet(m_edgeLabelSets[e]); }
+	int getEdgeLabelSetId(int e) const { return m_edgeLabelSets[e]; }
+	ConstRange_t<int> getLabelSet(int s) const
+	{
+		return ConstRange_t<int>(m_labelArena.data()+m_labelSetOffsets[s], 
+													m_labelArena.data()+m_labelSetOffsets[s+1]);
+	}
+	const std::map<int, std::pair<int, float>>& getLabelWeights() const { return m_labelWeights; }
+	// labels which are not in the label weight file have weight 0.0 (obstacle 0)
+	int getnLabels() const { return m_singleWeights.size(); }
+	float getSingleWeight(int l) const
+	{
+		return (l >= 0 and l < int(m_singleWeights.size())) ? m_singleWeights[l] : 0.0;
+	}
+	int getLabelObstacle(int l) const
+	{
+		return (l >= 0 and l < int(m_labelObstacles.size())) ? m_labelObstacles[l] : 0;
+	}
+	int getnObstacles() const { return m_nObstacles; }
+	std::uint64_t getLabelWeightsVersion() const { return m_labelWeightsVersion; }
+	const std::vector<int>& getMostPromisingLabels() const { return m_mostPromisingLabels; }
+	int getnLandmarks() const { return m_landmarks.size(); }
+	int getLandmark(int l) const { return m_landmarks[l]; }
+	// the shortest path cost from landmark l to every node
+	const float* getLandmarkDistances(int l) const { return m_landmarkDistances.data() + std::size_t(l)*m_nNodes; }
 	// Destructor
 	~Graph_t() {}
 };
@@ -0,0 +1,103 @@
+/* This cpp file defines the distance based heuristics of a search */
+
+#include <iostream>
+#include <limits>
+#include <algorithm>
+#include <cstdlib>
+
+#include "Heuristic.hpp"
+
+void SquaredDistances_t::build(const Graph_t &g, const std::vector<float> &point, bool isLazy)
+{
+	m_graph = &g;
+	m_point = point;
+	if (m_nValues != g.getnNodes())
+	{
+		m_values.reset(new float[g.getnNodes()]);
+		m_nValues = g.getnNodes();
+	}
+	m_isComputed.clear();
+	if (isLazy)
+	{
+		m_isComputed.assign((g.getnNodes() + 63) / 64, 0);
+	}
+	else
+	{
+		g.computeSquaredDistances(m_point.data(), m_values.get());
+	}
+}
+
+float SquaredDistances_t::compute(int i)
+{
+	// the dimensions are added up in the same order as in the kernels
+	StridedRange_t<float> state = m_graph->getState(i);
+	float temp_h = 0.0;
+	for (int j=0; j < state.size(); j++)
+	{
+		float d = state[j] - m_point[j];
+		temp_h += d*d;
+	}
+	m_values[i] = temp_h;
+	m_isComputed[i >> 6] |= std::uint64_t(1) << (i & 63);
+	return temp_h;
+}
+
+void GoalHeuristic_t::build(const Graph_t &g, const std::vector<int> &goalSet,
+										const GoalTable_t &goalTable, HeuristicMode_t mode)
+{
+	m_mode = mode;
+	m_goalTable = &goalTable;
+	m_graph = &g;
+	m_table = nullptr;
+	switch (m_mode)
+	{
+		case HEURISTIC_GOALMEAN:
+			m_table = g.getGoalMeanHeuristic(goalSet);
+			break;
+		case HEURISTIC_GOALMEAN_LAZY:
+			m_table = g.findGoalMeanHeuristic(goalSet);
+			if (!m_table)
+			{
+				m_distances.build(g, g.getGoalMean(goalSet), true);
+			}
+			break;
+		case HEURISTIC_LANDMARKS:
+			if (g.getnLandmarks() == 0)
+			{
+				std::cerr << "The graph has no landmarks, call computeLandmarks() first\n";
+				exit(1);
+			}
+			m_goalMin.assign(g.getnLandmarks(), std::numeric_limits<float>::infinity());
+			m_goalMax.assign(g.getnLandmarks(), 0.0);
+			for (int l=0; l < g.getnLandmarks(); l++)
+			{
+				const float *dist = g.getLandmarkDistances(l);
+				for (auto const &goal : goalSet)
+				{
+					m_goalMin[l] = std::min(m_goalMin[l], dist[goal]);
+					m_goalMax[l] = std::max(m_goalMax[l], dist[goal]);
+				}
+			}
+			break;
+		case HEURISTIC_COSTTOGO:
+			m_table = g.getCostToGo(goalSet);
+			break;
+	}
+}
+
+float GoalHeuristic_t::landmarkBound(int i) const
+{
+	float h = 0.0;
+	for (int l=0; l < m_goalMin.size(); l++)
+	{
+		float d = m_graph->getLandmarkDistances(l)[i];
+		// no bound from a landmark which does not reach both i and a goal
+		if (d == std::numeric_limits<float>::infinity() or 
+			m_goalMin[l] == std::numeric_limits<float>::infinity())
+		{
+			continue;
+		}
+		h = std::max(h, std::max(m_goalMin[l] - d, d - m_goalMax[l]));
+	}
+	return h;
+}
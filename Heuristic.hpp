@@ -0,0 +1,105 @@
+/* This hpp file declares the distance based heuristics of a search.
+
+SquaredDistances_t holds the squared euclidean distance of every node of a
+graph to one point. Eager: they are all computed up front with the graph's
+kernel (SIMD, split across threads). Lazy: the distance of a node is computed
+the first time it is asked for and memoized, so a query which generates only
+a few nodes does not pay for the whole graph.
+
+GoalHeuristic_t is the heuristic of the single-cost solvers, 0.0 at the goals:
+	HEURISTIC_GOALMEAN	euclidean distance between node i and the mean of
+				the goal set, the table shared by all the queries on the same
+				goal set (see Graph_t::getGoalMeanHeuristic)
+	HEURISTIC_GOALMEAN_LAZY	the same, computed node by node, unless another
+				query has already computed the table (the values are the same)
+	HEURISTIC_LANDMARKS	the ALT bound from the landmarks of the graph (see
+				Graph_t::computeLandmarks): for every landmark L, the path cost
+				from i to the closest goal is at least
+				min_t d(L,t) - d(L,i) and d(L,i) - max_t d(L,t),
+				the largest of these over the landmarks. It is admissible
+				for the edge costs and far tighter than the straight line
+				on cluttered roadmaps.
+	HEURISTIC_COSTTOGO	the exact cost of the cheapest path to the closest goal
+				(infinity if no goal can be reached), the table shared by all
+				the queries on the same goal set (see Graph_t::getCostToGo) */
+
+#ifndef HEURISTIC_H
+#define HEURISTIC_H
+
+#include <vector>
+#include <memory>
+#include <cmath>
+#include <cstdint>
+
+#include "Graph.hpp"
+#include "GoalTable.hpp"
+
+class SquaredDistances_t
+{
+	const Graph_t *m_graph;
+	std::vector<float> m_point;
+	// not initialized for the nodes which have not been computed yet, kept from
+	// one build to the next on the same number of nodes
+	std::unique_ptr<float[]> m_values;
+	int m_nValues;
+	// lazy only: one bit per node, set once its value is computed
+	std::vector<std::uint64_t> m_isComputed;
+
+	float compute(int i);
+
+public:
+	SquaredDistances_t() : m_graph(nullptr), m_nValues(0) {}
+
+	// distances of the nodes of g to point
+	void build(const Graph_t &g, const std::vector<float> &point, bool isLazy);
+	bool isLazy() const { return !m_isComputed.empty(); }
+
+	float operator[](int i)
+	{
+		if (m_isComputed.empty() or (m_isComputed[i >> 6] >> (i & 63) & 1)) { return m_values[i]; }
+		return compute(i);
+	}
+};
+
+enum HeuristicMode_t
+{
+	HEURISTIC_GOALMEAN = 0,
+	HEURISTIC_GOALMEAN_LAZY,
+	HEURISTIC_LANDMARKS,
+	HEURISTIC_COSTTOGO
+};
+
+class GoalHeuristic_t
+{
+	HeuristicMode_t m_mode;
+	const GoalTable_t *m_goalTable;
+	// goal mean and cost-to-go: the shared table (empty if lazy and not computed by
+	// another query)
+	std::shared_ptr<const std::vector<float>> m_table;
+	// lazy goal mean: the squared distances to the mean of the goals
+	SquaredDistances_t m_distances;
+	// landmarks: the tables of the graph and, for every landmark, the closest and
+	// the farthest goal (infinity if no goal is reachable from the landmark)
+	const Graph_t *m_graph;
+	std::vector<float> m_goalMin;
+	std::vector<float> m_goalMax;
+
+	float landmarkBound(int i) const;
+
+public:
+	GoalHeuristic_t() : m_mode(HEURISTIC_GOALMEAN), m_goalTable(nullptr), m_graph(nullptr) {}
+
+	// goalTable holds the goals of goalSet, it must outlive the heuristic
+	void build(const Graph_t &g, const std::vector<int> &goalSet, const GoalTable_t &goalTable,
+																			HeuristicMode_t mode);
+	HeuristicMode_t getMode() const { return m_mode; }
+
+	float operator[](int i)
+	{
+		if (m_table) { return (*m_table)[i]; }
+		if (m_goalTable->isGoal(i)) { return 0.0; }
+		return (m_mode == HEURISTIC_LANDMARKS) ? landmarkBound(i) : sqrt(m_distances[i]);
+	}
+};
+
+#endif
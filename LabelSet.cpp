@@ -0,0 +1,167 @@
+/* This cpp file defines how the label sets of a search are represented,
+given the labels of the graph, and the table of the label sets of a search */
+
+#include "LabelSet.hpp"
+#include "Graph.hpp"
+
+void LabelSpace_t::build(const Graph_t &g)
+{
+	// every label a node can carry comes from an edge label set
+	int minLabel = 0;
+	int maxLabel = -1;
+	for (int s=0; s < g.getnLabelSets(); s++)
+	{
+		for (auto const &l : g.getLabelSet(s))
+		{
+			minLabel = std::min(minLabel, l);
+			maxLabel = std::max(maxLabel, l);
+		}
+	}
+	m_isBitset = (minLabel >= 0 and maxLabel < LABELSET_MAX_BITSET_LABELS);
+	m_nWords = m_isBitset ? (maxLabel+1 + 63) / 64 : 0;
+	m_filter.clear();
+}
+
+void LabelSpace_t::setFilter(const std::vector<int> &labels)
+{
+	int maxLabel = -1;
+	for (auto const &l : labels) { maxLabel = std::max(maxLabel, l); }
+	// in bitset mode the filter covers all the words, so that unite() needs no bound check
+	int nWords = m_isBitset ? m_nWords : (maxLabel+1 + 63) / 64;
+	m_filter.assign(std::max(nWords, 1), 0);
+	for (auto const &l : labels)
+	{
+		if (l >= 0 and (l >> 6) < int(m_filter.size()))
+		{
+			m_filter[l >> 6] |= std::uint64_t(1) << (l & 63);
+		}
+	}
+}
+
+std::size_t LabelSet_t::hash() const
+{
+	std::size_t h = m_size;
+	for (auto const &w : m_words)
+	{
+		h ^= std::hash<std::uint64_t>()(w) + 0x9e3779b9 + (h << 6) + (h >> 2);
+	}
+	for (auto const &l : m_labels)
+	{
+		h ^= std::hash<int>()(l) + 0x9e3779b9 + (h << 6) + (h >> 2);
+	}
+	return h;
+}
+
+void LabelSetTable_t::build(const Graph_t &g, bool isDelta)
+{
+	m_graph = &g;
+	m_space.build(g);
+	m_isDelta = isDelta;
+	m_sets.clear();
+	m_index.clear();
+	m_deltas.clear();
+	m_unionCache.clear();
+	m_sets.push_back(m_space.emptySet());
+	m_index.emplace(m_sets[0].hash(), 0);
+	if (m_isDelta)
+	{
+		m_deltas.push_back(Delta_t{-1, -1, 0});
+		m_cacheIds.assign(DELTA_CACHE_SIZE, -1);
+		m_cacheSets.assign(DELTA_CACHE_SIZE, LabelSet_t());
+	}
+}
+
+void LabelSetTable_t::setFilter(const std::vector<int> &labels)
+{
+	m_space.setFilter(labels);
+	// the ids stay valid, the unions do not
+	m_unionCache.clear();
+}
+
+int LabelSetTable_t::intern(const LabelSet_t &s)
+{
+	std::size_t h = s.hash();
+	auto range = m_index.equal_range(h);
+	for (auto it = range.first; it != range.second; ++it)
+	{
+		if (m_sets[it->second] == s) { return it->second; }
+	}
+	m_sets.push_back(s);
+	m_index.emplace(h, m_sets.size()-1);
+	return m_sets.size()-1;
+}
+
+int LabelSetTable_t::unite(int s, const Graph_t &g, int e)
+{
+	std::uint64_t key = (std::uint64_t(s) << 32) | std::uint32_t(g.getEdgeLabelSetId(e));
+	auto it = m_unionCache.find(key);
+	if (it != m_unionCache.end()) { return it->second; }
+	int u;
+	if (!m_isDelta)
+	{
+		u = intern(m_space.unite(m_sets[s], g.getEdgeLabelsById(e)));
+	}
+	else
+	{
+		const LabelSet_t &base = build_set(s);
+		LabelSet_t set = m_space.unite(base, g.getEdgeLabelsById(e));
+		if (set.size() == base.size())
+		{
+			// the edge adds nothing
+			u = s;
+		}
+		else
+		{
+			u = m_deltas.size();
+			m_deltas.push_back(Delta_t{s, g.getEdgeLabelSetId(e), set.size()});
+			// the children of a node are usually expanded soon
+			cache_set(u, std::move(set));
+		}
+	}
+	m_unionCache.emplace(key, u);
+	return u;
+}
+
+bool LabelSetTable_t::includes(int set, int subset) const
+{
+	if (set == subset) { return true; }
+	if (size(subset) > size(set)) { return false; }
+	if (!m_isDelta) { return m_space.includes(m_sets[set], m_sets[subset]); }
+	if ((set & (DELTA_CACHE_SIZE-1)) == (subset & (DELTA_CACHE_SIZE-1)))
+	{
+		// both would go into the same cache slot
+		LabelSet_t sub = build_set(subset);
+		return m_space.includes(build_set(set), sub);
+	}
+	const LabelSet_t &sup = build_set(set);
+	return m_space.includes(sup, build_set(subset));
+}
+
+const LabelSet_t& LabelSetTable_t::build_set(int s) const
+{
+	if (s == 0) { return m_sets[0]; }
+	int slot = s & (DELTA_CACHE_SIZE-1);
+	if (m_cacheIds[slot] == s) { return m_cacheSets[slot]; }
+	// walk back to the empty set or to a set in the cache
+	std::vector<int> chain;
+	int a = s;
+	while (a != 0 and m_cacheIds[a & (DELTA_CACHE_SIZE-1)] != a)
+	{
+		chain.push_back(a);
+		a = m_deltas[a].m_base;
+	}
+	LabelSet_t set = (a == 0) ? m_sets[0] : m_cacheSets[a & (DELTA_CACHE_SIZE-1)];
+	for (int i = chain.size()-1; i >= 0; i--)
+	{
+		set = m_space.unite(set, m_graph->getLabelSet(m_deltas[chain[i]].m_edgeSet));
+	}
+	cache_set(s, std::move(set));
+	return m_cacheSets[slot];
+}
+
+void LabelSetTable_t::cache_set(int s, LabelSet_t &&set) const
+{
+	int slot = s & (DELTA_CACHE_SIZE-1);
+	m_cacheIds[slot] = s;
+	m_cacheSets[slot] = std::move(set);
+}
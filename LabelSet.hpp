@@ -0,0 +1,228 @@
+/* This hpp file declares the label sets carried by the search nodes.
+
+A label set is a fixed-width bitset when the labels of the graph fit in
+LABELSET_MAX_BITSET_LABELS bits: a union with the labels of an edge sets a
+few bits, the cardinality is kept as the bits are set, and a subset test is
+an AND-NOT over the words. With more labels than that a set is a sorted
+vector of labels instead. Which one is used is decided once per search by
+LabelSpace_t from the labels of the graph; all the sets of a search use the
+same one. Either way a label appears at most once in a set.
+
+The nodes of a search do not hold label sets themselves: LabelSetTable_t
+keeps every distinct set of the search once (hash-consing) and a node only
+holds the 32-bit id of its set. The union of a set with the labels of an
+edge is remembered by (set id, edge label set id), so a union which has
+been done before along the frontier is one hash lookup.
+
+For long exact searches the table can instead keep every set as a delta: the
+set it was made from, the label set of the edge which was added and its
+cardinality. Sets are then only built when they are looked at (dominance
+checks, survival, goal reporting), walking back to the closest set which is
+still in a small cache of built sets. Sets are not hash-consed in this mode,
+equal sets reached along different paths get different ids. */
+
+#ifndef LABELSET_H
+#define LABELSET_H
+
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <unordered_map>
+#include <cstddef>
+
+#include "ConstRange.hpp"
+
+class Graph_t;
+
+// above this many labels the sets are sparse
+const int LABELSET_MAX_BITSET_LABELS = 4096;
+
+class LabelSet_t
+{
+	friend class LabelSpace_t;
+
+	std::vector<std::uint64_t> m_words; // bitset: bit l of the set is label l
+	std::vector<int> m_labels; // sparse: the sorted labels
+	int m_size;
+
+public:
+	LabelSet_t() : m_size(0) {}
+
+	int size() const { return m_size; }
+	bool empty() const { return m_size == 0; }
+	// call f(label) for every label in increasing order
+	template <typename F>
+	void forEach(F f) const;
+	std::vector<int> toVector() const;
+
+	std::size_t hash() const;
+	bool operator==(const LabelSet_t &o) const { return m_words == o.m_words and m_labels == o.m_labels; }
+};
+
+class LabelSpace_t
+{
+	bool m_isBitset;
+	int m_nWords;
+	// labels kept by unite() (all of them if empty), one bit per label
+	std::vector<std::uint64_t> m_filter;
+
+	void set(LabelSet_t &s, int label) const;
+
+public:
+	LabelSpace_t() : m_isBitset(false), m_nWords(0) {}
+
+	// pick the representation for the labels of g
+	void build(const Graph_t &g);
+	// only keep these labels in the result of unite() from now on
+	void setFilter(const std::vector<int> &labels);
+	bool isBitset() const { return m_isBitset; }
+
+	LabelSet_t emptySet() const;
+	// s with the labels of an edge added
+	LabelSet_t unite(const LabelSet_t &s, ConstRange_t<int> labels) const;
+	// true if every label of subset is in set
+	bool includes(const LabelSet_t &set, const LabelSet_t &subset) const;
+};
+
+// the label sets of one search, by id
+class LabelSetTable_t
+{
+	// a set kept as a delta: m_base with the labels of label set m_edgeSet of the graph
+	struct Delta_t
+	{
+		int m_base;
+		int m_edgeSet;
+		int m_size;
+	};
+	// number of built sets kept in delta mode (a power of 2)
+	static const int DELTA_CACHE_SIZE = 1024;
+
+	const Graph_t *m_graph;
+	LabelSpace_t m_space;
+	bool m_isDelta;
+	// full mode: every set. delta mode: only the empty set
+	std::vector<LabelSet_t> m_sets;
+	// hash of a set -> ids of the sets with that hash (full mode only)
+	std::unordered_multimap<std::size_t, int> m_index;
+	// delta mode: every set
+	std::vector<Delta_t> m_deltas;
+	// delta mode: set s, once built, is kept in slot s % DELTA_CACHE_SIZE
+	mutable std::vector<int> m_cacheIds;
+	mutable std::vector<LabelSet_t> m_cacheSets;
+	// (set id, edge label set id) -> id of their union
+	std::unordered_map<std::uint64_t, int> m_unionCache;
+
+	const LabelSet_t& build_set(int s) const;
+	void cache_set(int s, LabelSet_t &&set) const;
+
+public:
+	LabelSetTable_t() : m_graph(nullptr), m_isDelta(false) {}
+
+	// start over with the labels of g, the empty set gets id 0
+	void build(const Graph_t &g, bool isDelta = false);
+	// only keep these labels in the result of unite() from now on
+	void setFilter(const std::vector<int> &labels);
+	bool isDelta() const { return m_isDelta; }
+
+	// return the id of s, adding it if it has not been seen (full mode only)
+	int intern(const LabelSet_t &s);
+	int emptySet() const { return 0; }
+	// id of set s with the labels of edge e of g added
+	int unite(int s, const Graph_t &g, int e);
+	// true if every label of subset is in set
+	bool includes(int set, int subset) const;
+
+	// in delta mode the reference is only good until the next get() or includes()
+	const LabelSet_t& get(int s) const { return m_isDelta ? build_set(s) : m_sets[s]; }
+	int size(int s) const { return m_isDelta ? m_deltas[s].m_size : m_sets[s].size(); }
+	int getnSets() const { return m_isDelta ? m_deltas.size() : m_sets.size(); }
+};
+
+template <typename F>
+void LabelSet_t::forEach(F f) const
+{
+	if (m_words.empty())
+	{
+		for (auto const &l : m_labels) { f(l); }
+		return;
+	}
+	for (int w=0; w < int(m_words.size()); w++)
+	{
+		std::uint64_t bits = m_words[w];
+		while (bits)
+		{
+			f(64*w + __builtin_ctzll(bits));
+			bits &= bits-1;
+		}
+	}
+}
+
+inline std::vector<int> LabelSet_t::toVector() const
+{
+	if (m_words.empty()) { return m_labels; }
+	std::vector<int> v;
+	v.reserve(m_size);
+	forEach([&v](int l) { v.push_back(l); });
+	return v;
+}
+
+inline void LabelSpace_t::set(LabelSet_t &s, int label) const
+{
+	std::uint64_t bit = std::uint64_t(1) << (label & 63);
+	std::uint64_t &word = s.m_words[label >> 6];
+	s.m_size += !(word & bit);
+	word |= bit;
+}
+
+inline LabelSet_t LabelSpace_t::emptySet() const
+{
+	LabelSet_t s;
+	if (m_isBitset) { s.m_words.assign(m_nWords, 0); }
+	return s;
+}
+
+inline LabelSet_t LabelSpace_t::unite(const LabelSet_t &s, ConstRange_t<int> labels) const
+{
+	if (m_isBitset)
+	{
+		LabelSet_t r = s;
+		for (auto const &l : labels)
+		{
+			if (m_filter.empty() or (m_filter[l >> 6] >> (l & 63) & 1)) { set(r, l); }
+		}
+		return r;
+	}
+	// sparse: merge the sorted labels, then drop repeated ones
+	LabelSet_t r;
+	r.m_labels.resize(s.m_labels.size() + labels.size());
+	auto it = std::set_union(s.m_labels.begin(), s.m_labels.end(),
+									labels.begin(), labels.end(), r.m_labels.begin());
+	r.m_labels.resize(std::unique(r.m_labels.begin(), it) - r.m_labels.begin());
+	if (!m_filter.empty())
+	{
+		r.m_labels.erase(std::remove_if(r.m_labels.begin(), r.m_labels.end(), [this](int l) {
+			return l < 0 or (l >> 6) >= int(m_filter.size()) or !(m_filter[l >> 6] >> (l & 63) & 1); }),
+																					r.m_labels.end());
+	}
+	r.m_size = r.m_labels.size();
+	return r;
+}
+
+inline bool LabelSpace_t::includes(const LabelSet_t &set, const LabelSet_t &subset) const
+{
+	if (subset.m_size > set.m_size) { return false; }
+	if (m_isBitset)
+	{
+		// no early exit so that the loop vectorizes
+		std::uint64_t missing = 0;
+		for (int w=0; w < m_nWords; w++)
+		{
+			missing |= subset.m_words[w] & ~set.m_words[w];
+		}
+		return missing == 0;
+	}
+	return std::includes(set.m_labels.begin(), set.m_labels.end(),
+							subset.m_labels.begin(), subset.m_labels.end());
+}
+
+#endif
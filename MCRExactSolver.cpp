@@ -5,298 +5,184 @@ with specified start and goal */
 #include <iostream>
 #include <cmath>
 #include <algorithm>
+#include <limits>
 
 #include "Graph.hpp"
 #include "MCRExactSolver.hpp"
 #include "Timer.hpp"
 
 
-MCRExactSolver_t::MCRExactSolver_t(Graph_t &g, int start, std::vector<int> goalSet)
+MCRExactSolver_t::MCRExactSolver_t(const Graph_t &g, int start, std::vector<int> goalSet, bool deltaLabels, 
+									HeuristicMode_t heuristic) : m_heuristic(heuristic)
 {
-	//initialize the start & goalSet
-	m_start = start;
-	m_goalSet = goalSet;
-	m_targetPoses = g.getTargetPoses();
-	for (int i=0; i < m_goalSet.size(); i++)
-	{
-		m_goalmap[m_goalSet[i]] = m_targetPoses[i];
-	}
-	// essential elements for MCR exact search
-	computeH(g); // heuristics
-	m_open.push( new MCRENode_t(m_start, m_H[m_start], 0.0+m_H[m_start], {}, 0, nullptr) );
-	m_visited = std::vector<bool>(g.getnNodes(), false);
-	m_visited[m_start] = true;
-	int n_nodes = g.getnNodes();
-	for (int hh=0; hh < n_nodes; hh++)
-	{
-		m_recordSet.push_back(std::vector<std::vector<int>>());
-	}
-
-	m_isFailure = false;
-
-
+	m_labelSets.build(g, deltaLabels);
+	reset(g, start, goalSet);
 }
 
-MCRExactSolver_t::~MCRExactSolver_t()
+void MCRExactSolver_t::reset(const Graph_t &g, int start, std::vector<int> goalSet)
 {
-	while (!m_open.empty())
-	{
-		MCRENode_t* a1 = m_open.top();
-		delete a1;
-		m_open.pop();
-	}
-	for (auto &e : m_closed) { delete e; }
+	//initialize the start & goalSet
+	init_goals(g, start, goalSet);
+	// keep the label representation picked by the constructor
+	m_labelSets.build(g, m_labelSets.isDelta());
+	// essential elements for MCR exact search
+	computeH(g, m_heuristic); // heuristics
+	m_open.push( m_start, m_nodes.create(m_start, m_H[m_start], 0.0+m_H[m_start], m_labelSets.emptySet(), 0, -1) );
+	m_visited.init(g.getnNodes());
+	m_visited.insert(m_start);
+	m_recordSet.init(g.getnNodes(), std::vector<int>());
+	m_labelLowerBound = 0;
+	m_isAnytime = false;
+	m_incumbentIdx = -1;
+	m_incumbentSize = std::numeric_limits<int>::max();
 }
 
-
-void MCRExactSolver_t::MCRExact_search(Graph_t &g)
+void MCRExactSolver_t::MCRExact_search(const Graph_t &g)
 {
-	while (!m_open.empty())
-	{
-		MCRENode_t *current = m_open.top();
-		m_open.pop();
-
-		m_closed.push_back(current);
-		// a goal in the goalSet has been found
-		if ( std::find(m_goalSet.begin(), m_goalSet.end(), current->m_id) != m_goalSet.end() )
-		{
-			std::cout << "Goal is connected all the way to the start\n";
-			back_track_path(); // construct your path
-			pathToTrajectory(g);
-			m_goalLabels = current->m_labels;
-			// printLabels();
-			// print the pose the goal indicates
-			m_goalIdxReached = m_goalmap[current->m_id];
-			m_pathCost = current->m_f;
-			// std::cout << "The reaching target pose is: " << m_goalIdxReached << "\n";
-			// std::cout << "The cost: " << m_pathCost << "\n";
-			return;			
-		}
-		// If it is not the goal, let's keep moving
-		// look at each neighbor of the current node
-		std::vector<int> neighbors = g.getNodeNeighbors(current->m_id);
-		for (auto const &neighbor : neighbors)
-		{
-			// check neighbor's labels
-			std::vector<int> neighborLabels = 
-				label_union(current->m_labels, g.getEdgeLabels(current->m_id, neighbor));
-
-			// check whether we need to put this neighbor into the priority queue (based on labels)
-			// Every time we look at a neighbor, check if the labels it carries
-			// is a super set of any of the set in the m_recordSet ( except for the first time :) )
-
-			// The first time visited
-			if (m_visited[neighbor] == false)
-			{
-				int labelsSize = neighborLabels.size();
-				float temp_g = (current->m_f-current->m_h) + g.getEdgeCost(current->m_id, neighbor);
-				// now put it to the open list
-				m_open.push( new MCRENode_t(neighbor, m_H[neighbor], temp_g+m_H[neighbor], 
-															neighborLabels, labelsSize, current) );
-				m_recordSet[neighbor].push_back(neighborLabels);
-				m_visited[neighbor] = true;
-				continue;
-			}
-			else // not the first time visited
-			{
-				// check if the label set is a super set of any set that 
-				// we have seen before in m_recordSet
-				if (!check_superset(neighbor, neighborLabels))
-				{
-					int labelsSize = neighborLabels.size();
-					float temp_g = (current->m_f-current->m_h) + 
-															g.getEdgeCost(current->m_id, neighbor);
-					// now put it to the open list
-					m_open.push( new MCRENode_t(neighbor, m_H[neighbor], temp_g+m_H[neighbor], 
-															neighborLabels, labelsSize, current) );
-					m_recordSet[neighbor].push_back(neighborLabels);
-
-				}		
-			}
-		}
-
-	}
-	// You are reaching here since the open list is empty and the goal is not found
-	std::cout << "The problem is not solvable. Search failed...\n";
-	m_isFailure = true;
+	search(g);
+	if (!m_isFailure) { m_labelLowerBound = m_goalLabels.size(); }
 }
 
-void MCRExactSolver_t::computeH(Graph_t &g)
+void MCRExactSolver_t::MCRExactAnytime_search(const Graph_t &g, double timeBudget, int maxExpansions)
 {
-	std::vector<float> goal_mean = std::vector<float>(g.getState(0).size(), 0.0);
-	for (auto const &goal : m_goalSet)
-	{
-		std::vector<float> v_goal = g.getState(goal);
-		for (int j=0; j < v_goal.size(); j++)
-		{
-			goal_mean[j] = goal_mean[j] + v_goal[j];
-		}
-	}
-	for (int j=0; j < goal_mean.size(); j++)
+	Timer timer;
+	// the greedy answer is the first best path
+	if (!m_greedy) { m_greedy.reset(new MCRGreedySolver_t(g, m_start, m_goalSet, m_heuristic)); }
+	else { m_greedy->reset(g, m_start, m_goalSet); }
+	m_greedy->MCRGreedy_search(g);
+	if (m_greedy->getFailureIndicator())
 	{
-		goal_mean[j] = goal_mean[j] / m_goalSet.size();
+		// the greedy search reaches every node the exact one does
+		m_isFailure = true;
+		return;
 	}
-
-	std::vector<float> temp_v;
-	for (int i=0; i < g.getnNodes(); i++)
+	m_path = m_greedy->getPath();
+	m_trajectory = m_greedy->getTrajectory();
+	m_goalLabels = m_greedy->getGoalLabels();
+	m_goalIdxReached = m_greedy->getGoalIdxReached();
+	m_pathCost = m_greedy->getPathCost();
+	m_isAnytime = true;
+	m_incumbentIdx = -1;
+	m_incumbentSize = m_goalLabels.size();
+
+	// the exact search, with the nodes which cannot beat the best path left out and the
+	// goals taken as the best path as soon as they are generated (see relax)
+	bool isOutOfBudget = false;
+	int nExpansions = 0;
+	while (!m_open.empty())
 	{
-		if (std::find(m_goalSet.begin(), m_goalSet.end(), i) != m_goalSet.end())
+		if ((timeBudget > 0 and timer.elapsed() >= timeBudget) or 
+							(maxExpansions > 0 and nExpansions >= maxExpansions))
 		{
-			m_H.push_back(0.0);
-			continue;
+			isOutOfBudget = true;
+			break;
 		}
-		// compute euclidean distance
-		float temp_h = 0.0;
-		temp_v = g.getState(i);
-		for (int j=0; j < goal_mean.size(); j++)
+		int currentIdx = m_open.pop();
+		const MCRENode_t *current = &m_nodes[currentIdx];
+		// the nodes come out by increasing label count, so every path still to be found
+		// carries at least as many labels as this node
+		if (current->m_labelCardinality >= m_incumbentSize) { break; }
+		m_labelLowerBound = current->m_labelCardinality;
+		m_closed.push_back(currentIdx);
+		nExpansions++;
+		ConstRange_t<int> neighbors = g.getNodeNeighbors(current->m_id);
+		ConstRange_t<int> edges = g.getNodeEdges(current->m_id);
+		for (int k=0; k < neighbors.size(); k++)
 		{
-			temp_h += pow(goal_mean[j]-temp_v[j], 2);
+			relax(g, current, currentIdx, neighbors[k], edges[k]);
 		}
-		temp_h = sqrt(temp_h);
-		m_H.push_back(temp_h);
 	}
-}
+	// out of nodes to look at: nothing beats the best path
+	if (!isOutOfBudget) { m_labelLowerBound = m_incumbentSize; }
 
-void MCRExactSolver_t::checkPathSuccess(int nhypo)
-{
-	m_obstaclesCollided = 0;
-	m_isPathSuccess = true;
-	// compute the obstacles collided
-	// loop through the m_goalLabels
-	for (auto const &l : m_goalLabels)
+	if (m_incumbentIdx != -1)
 	{
-		if (l % nhypo == 0)
+		// the exact search has beaten the greedy path
+		const MCRENode_t *goal = &m_nodes[m_incumbentIdx];
+		m_path.clear();
+		for (int n = m_incumbentIdx; n != -1; n = m_nodes[n].m_parent)
 		{
-			m_obstaclesCollided += 1;
+			m_path.push_back(m_nodes[n].m_id);
 		}
+		m_trajectory.clear();
+		pathToTrajectory(g);
+		harvest(g, goal);
+		m_goalIdxReached = m_goalTable->getTargetPose(goal->m_id);
+		m_pathCost = goal->m_f;
 	}
-	if (m_obstaclesCollided != 0 or m_goalIdxReached != 0)
+	if (isOutOfBudget)
 	{
-		m_isPathSuccess = false;
+		std::cout << "Out of budget: the best path carries " << m_incumbentSize 
+					<< " labels, no path carries fewer than " << m_labelLowerBound << "\n";
 	}
-
 }
 
-void MCRExactSolver_t::back_track_path()
+void MCRExactSolver_t::relax(const Graph_t &g, const MCRENode_t *current, int currentIdx, int neighbor, int e)
 {
-	// start from the goal
-	MCRENode_t *current = m_closed[m_closed.size()-1];
-	while (current->m_id != m_start)
-	{
-		// keep backtracking the path until you reach the start
-		m_path.push_back(current->m_id);
-		current = current->m_parent;
-	}
-	// finally put the start into the path
-	m_path.push_back(current->m_id);
+	float edgeCost = g.getEdgeCostById(e);
+	// check neighbor's labels
+	int neighborLabels = m_labelSets.unite(current->m_labels, g, e);
+	// anytime: as many labels as the best path already, no better path through here
+	if (m_isAnytime and m_labelSets.size(neighborLabels) >= m_incumbentSize) { return; }
 
-	// print the path for checking purpose
-	// std::cout << "path: \n";
-	// for (auto const &waypoint : m_path)
-	// {
-	// 	std::cout << waypoint << " ";
-	// }
-	// std::cout << "\n";	
-}
+	// check whether we need to put this neighbor into the priority queue (based on labels)
+	// Every time we look at a neighbor, check if the labels it carries
+	// is a super set of any of the set in the m_recordSet ( except for the first time :) )
 
-void MCRExactSolver_t::pathToTrajectory(Graph_t &g)
-{
-	// start from the start
-	for (int i=m_path.size()-1; i >=0; i--)
+	// The first time visited
+	if (m_visited[neighbor] == false)
 	{
-		m_trajectory.push_back(g.getState(m_path[i]));
-
+		int labelsSize = m_labelSets.size(neighborLabels);
+		float temp_g = (current->m_f-current->m_h) + edgeCost;
+		// now put it to the open list
+		int neighborIdx = m_nodes.create(neighbor, m_H[neighbor], temp_g+m_H[neighbor], 
+													neighborLabels, labelsSize, currentIdx);
+		m_open.push(neighbor, neighborIdx);
+		m_recordSet.at(neighbor).push_back(neighborLabels);
+		m_visited.insert(neighbor);
+		if (m_isAnytime) { update_incumbent(neighborIdx); }
+		return;
 	}
-	// // print the trajectory for checking purpose
-	// std::cout << "The trajectory: \n";
-	// for (auto const &t : m_trajectory)
-	// {
-	// 	for (auto const &d : t)
-	// 	{
-	// 		std::cout << d << "   ";
-	// 	}
-	// 	std::cout << "\n";
-	// }
-}
-
-void MCRExactSolver_t::writeTrajectory(std::string trajectory_file)
-{
-	m_outFile_.open(trajectory_file);
-	if (m_outFile_.is_open())
+	else // not the first time visited
 	{
-		for (auto const &t : m_trajectory)
+		// check if the label set is a super set of any set that 
+		// we have seen before in m_recordSet
+		if (!check_superset(neighbor, neighborLabels))
 		{
-			for (auto const &d : t)
-			{
-				m_outFile_ << d << " ";
-			}
-			m_outFile_ << "\n";
-		}
-	}
-	m_outFile_.close();
-
-}
-
-void MCRExactSolver_t::print_path()
-{
-	// print the path for checking purpose
-	std::cout << "path: \n";
-	for (auto const &waypoint : m_path)
-	{
-		std::cout << waypoint << " ";
+			int labelsSize = m_labelSets.size(neighborLabels);
+			float temp_g = (current->m_f-current->m_h) + 
+													edgeCost;
+			// now put it to the open list
+			int neighborIdx = m_nodes.create(neighbor, m_H[neighbor], temp_g+m_H[neighbor], 
+													neighborLabels, labelsSize, currentIdx);
+			m_open.push(neighbor, neighborIdx);
+			m_recordSet.at(neighbor).push_back(neighborLabels);
+			if (m_isAnytime) { update_incumbent(neighborIdx); }
+
+		}		
 	}
-	std::cout << "\n";
 }
 
-void MCRExactSolver_t::printLabels()
+void MCRExactSolver_t::update_incumbent(int nodeIdx)
 {
-	std::cout << "labels: " << "< ";
-	for (auto const &l : m_goalLabels)
+	// relax() has left out the nodes with as many labels as the best path
+	const MCRENode_t *n = &m_nodes[nodeIdx];
+	if (m_goalTable->isGoal(n->m_id))
 	{
-		std::cout << l << " ";
+		m_incumbentIdx = nodeIdx;
+		m_incumbentSize = n->m_labelCardinality;
 	}
-	std::cout << ">\n";	
 }
 
-void MCRExactSolver_t::print_cost()
-{
-	std::cout << "cost: " << m_pathCost << "\n";
-}
-		
-void MCRExactSolver_t::print_goalIdxReached()
+void MCRExactSolver_t::computeH(const Graph_t &g, HeuristicMode_t heuristic)
 {
-	std::cout << "The reaching target pose is: " << m_goalIdxReached << "\n";
-}
-
-void MCRExactSolver_t::printAll()
-{
-	print_path();
-	print_cost();
-	printLabels();
-	print_goalIdxReached();
-}
-
-std::vector<int> MCRExactSolver_t::label_union(std::vector<int> s1, std::vector<int> s2)
-{
-	// sort the sets first before applying union operation
-	std::sort(s1.begin(), s1.end());
-	std::sort(s2.begin(), s2.end());
-
-	// Declaring resultant vector for union
-	std::vector<int> v(s1.size()+s2.size());
-	// using function set_union() to compute union of 2
-	// containers v1 and v2 and store result in v
-	auto it = std::set_union(s1.begin(), s1.end(), s2.begin(), s2.end(), v.begin());
-
-	// resizing new container
-	v.resize(it - v.begin());
-	return v;
+	m_H.build(g, m_goalSet, *m_goalTable, heuristic);
 }
 
-bool MCRExactSolver_t::check_superset(int neighbor, std::vector<int> neighborLabels)
+bool MCRExactSolver_t::check_superset(int neighbor, int neighborLabels)
 {
 	bool isSuperset = false;
-	for (auto const s: m_recordSet[neighbor])
+	for (auto const &s: m_recordSet[neighbor])
 	{
 		if ( check_subset(neighborLabels, s) ) { return true; }
 	}
@@ -304,8 +190,8 @@ bool MCRExactSolver_t::check_superset(int neighbor, std::vector<int> neighborLab
 	return isSuperset;
 }
 
-bool MCRExactSolver_t::check_subset(std::vector<int> set, std::vector<int> subset)
+bool MCRExactSolver_t::check_subset(int set, int subset)
 {
 	// This function check whether a input set of labels is a subset of the m_currentLabels
-	return ( std::includes(set.begin(), set.end(), subset.begin(), subset.end()) );	
+	return m_labelSets.includes(set, subset);
 }
\ No newline at end of file
@@ -8,8 +8,13 @@ with specified start and goal*/
 #include <queue>
 #include <cstring>
 #include <fstream>
+#include <memory>
 
 #include "Graph.hpp"
+#include "SearchCore.hpp"
+#include "Heuristic.hpp"
+#include "StampedArray.hpp"
+#include "MCRGreedySolver.hpp"
 
 struct MCRENode_t
 {
@@ -17,12 +22,18 @@ struct MCRENode_t
 	float m_h;
 	float m_f;
 	// label and cardinality
-	std::vector<int> m_labels;
+	int m_labels; // id of the label set in the search's LabelSetTable_t
 	int m_labelCardinality;
 
-	MCRENode_t *m_parent;
+	int m_parent; // index of the parent in the node pool, -1 for the start
 
-	MCRENode_t(int id, float h, float f, std::vector<int> ls, int c, MCRENode_t *p)
+	// the priority key, kept in the open list
+	struct Key_t { int m_labelCardinality; float m_f; float m_h; };
+	Key_t key() const { return Key_t{m_labelCardinality, m_f, m_h}; }
+	// the open list keeps one bucket per label cardinality
+	int bucket() const { return m_labelCardinality; }
+
+	MCRENode_t(int id, float h, float f, int ls, int c, int p)
 	{
 		m_id = id;
 		m_h = h;
@@ -35,7 +46,9 @@ struct MCRENode_t
 
 struct MCRENode_comparison
 {
-	bool operator()(const MCRENode_t* a, const MCRENode_t* b)
+	// compares nodes or their keys
+	template <typename T>
+	bool operator()(const T* a, const T* b)
 	{
 		if (a->m_labelCardinality == b->m_labelCardinality)
 		{
@@ -51,59 +64,56 @@ struct MCRENode_comparison
 	}
 };
 
-class MCRExactSolver_t
+class MCRExactSolver_t : public SearchCore_t<MCRExactSolver_t, MCRENode_t, MCRENode_comparison,
+							BucketOpenList_t<MCRENode_t, MCRENode_comparison, false>>
 {
-	std::vector<int> m_path;
-	std::vector<std::vector<float>> m_trajectory;
-
-	std::priority_queue<MCRENode_t*, std::vector<MCRENode_t*>, MCRENode_comparison> m_open;	
-	std::vector<MCRENode_t*> m_closed;
-	std::vector<bool> m_visited;
-	std::vector<std::vector<std::vector<int>>> m_recordSet;
-	std::vector<float> m_H;
-
-	int m_start;
-	std::vector<int> m_goalSet;
-	std::vector<int> m_targetPoses;
-	std::map<int, int> m_goalmap;
-
-	std::ofstream m_outFile_;
-	bool m_isFailure;
-
-	std::vector<int> m_goalLabels;
-	int m_goalIdxReached;
-	int m_obstaclesCollided;
-	bool m_isPathSuccess;
-	float m_pathCost;
+	friend class SearchCore_t<MCRExactSolver_t, MCRENode_t, MCRENode_comparison, BucketOpenList_t<MCRENode_t, MCRENode_comparison, false>>;
+
+	StampedSet_t m_visited;
+	StampedArray_t<std::vector<int>> m_recordSet;
+	HeuristicMode_t m_heuristic;
+	GoalHeuristic_t m_H;
+
+	// no path carries fewer labels than this
+	int m_labelLowerBound;
+	// anytime search only: the best goal node generated so far (-1 while the best path
+	// is the greedy one) and the label count of the best path
+	bool m_isAnytime;
+	int m_incumbentIdx;
+	int m_incumbentSize;
+	// the greedy search which gives the first best path, kept for its buffers
+	std::unique_ptr<MCRGreedySolver_t> m_greedy;
+
+	// search policies (see SearchCore.hpp)
+	void relax(const Graph_t &g, const MCRENode_t *current, int currentIdx, int neighbor, int e);
+	// anytime: a generated goal becomes the best path
+	void update_incumbent(int nodeIdx);
 
 public:
-	MCRExactSolver_t(Graph_t &g, int start, std::vector<int> goalSet);
-	~MCRExactSolver_t();
-
-	void computeH(Graph_t &g);
-	void MCRExact_search(Graph_t &g);
-	void back_track_path();
-	void pathToTrajectory(Graph_t &g);
-	void writeTrajectory(std::string trajectory_file);
-	void printLabels();
-	void print_path();
-	void print_cost();
-	void print_goalIdxReached();
-	void printAll();
-
-	std::vector<int> label_union(std::vector<int> s1, std::vector<int> s2);
-	bool check_superset(int, std::vector<int>);	
-	bool check_subset(std::vector<int>, std::vector<int>);
-
-	// harvest the results
-	void checkPathSuccess(int nhypo);
-
-	// getters
-	std::vector<std::vector<float>> getTrajectory() {return m_trajectory;}
-	bool getFailureIndicator() {return m_isFailure;}
-	int getObstaclesCollided() {return m_obstaclesCollided;}
-	bool getIsPathSuccess() {return m_isPathSuccess;}
-	float getPathCost() {return m_pathCost;}
+	// deltaLabels: keep the label sets as parent deltas (see LabelSet.hpp), less memory
+	// on long searches for some more time per dominance check
+	// heuristic: which h to use (see Heuristic.hpp)
+	MCRExactSolver_t(const Graph_t &g, int start, std::vector<int> goalSet, bool deltaLabels = false, 
+														HeuristicMode_t heuristic = HEURISTIC_GOALMEAN);
+	// start over with another query on the same graph, label representation and
+	// heuristic mode, reusing the buffers: costs the previous search, not the size of the graph
+	void reset(const Graph_t &g, int start, std::vector<int> goalSet);
+
+	void computeH(const Graph_t &g, HeuristicMode_t heuristic = HEURISTIC_GOALMEAN);
+	void MCRExact_search(const Graph_t &g);
+	// anytime search, once per query: the MCR greedy answer right away, then the exact
+	// search improves on it until it proves the best path optimal or runs out of budget
+	// (timeBudget seconds from the call, the greedy search included, maxExpansions exact
+	// expansions, no limit if <= 0). The results are
+	// those of the best path found, getLabelLowerBound() a proven lower bound on the label
+	// count of any path
+	void MCRExactAnytime_search(const Graph_t &g, double timeBudget, int maxExpansions = 0);
+	int getLabelLowerBound() {return m_labelLowerBound;}
+	// true if no path carries fewer labels than the one found
+	bool isProvenOptimal() {return !m_isFailure and m_labelLowerBound == (int)m_goalLabels.size();}
+
+	bool check_superset(int, int);	
+	bool check_subset(int, int);
 };
 
 #endif
\ No newline at end of file
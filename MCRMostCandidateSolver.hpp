@@ -10,6 +10,9 @@ with specified start and goal set */
 #include <fstream>
 
 #include "Graph.hpp"
+#include "SearchCore.hpp"
+#include "Heuristic.hpp"
+#include "StampedArray.hpp"
 
 struct MCRMCNode_t
 {
@@ -17,12 +20,18 @@ struct MCRMCNode_t
 	float m_h;
 	float m_f;
 	// label and cardinality
-	std::vector<int> m_labels;
+	int m_labels; // id of the label set in the search's LabelSetTable_t
 	int m_labelCardinality;
 
-	MCRMCNode_t *m_parent;
+	int m_parent; // index of the parent in the node pool, -1 for the start
 
-	MCRMCNode_t(int id, float h, float f, std::vector<int> ls, int c, MCRMCNode_t *p)
+	// the priority key, kept in the open list
+	struct Key_t { int m_labelCardinality; float m_f; float m_h; };
+	Key_t key() const { return Key_t{m_labelCardinality, m_f, m_h}; }
+	// the open list keeps one bucket per label cardinality
+	int bucket() const { return m_labelCardinality; }
+
+	MCRMCNode_t(int id, float h, float f, int ls, int c, int p)
 	{
 		m_id = id;
 		m_h = h;
@@ -35,7 +44,9 @@ struct MCRMCNode_t
 
 struct MCRMCNode_comparison
 {
-	bool operator()(const MCRMCNode_t* a, const MCRMCNode_t* b)
+	// compares nodes or their keys
+	template <typename T>
+	bool operator()(const T* a, const T* b)
 	{
 		if (a->m_labelCardinality == b->m_labelCardinality)
 		{
@@ -52,60 +63,35 @@ struct MCRMCNode_comparison
 };
 
 
-class MCRMostCandidateSolver_t
+class MCRMostCandidateSolver_t : public SearchCore_t<MCRMostCandidateSolver_t, MCRMCNode_t, MCRMCNode_comparison,
+							BucketOpenList_t<MCRMCNode_t, MCRMCNode_comparison, true>>
 {
-	std::vector<int> m_path;
-	std::vector<std::vector<float>> m_trajectory;
-
-	std::priority_queue<MCRMCNode_t*, std::vector<MCRMCNode_t*>, MCRMCNode_comparison> m_open;	
-	std::vector<MCRMCNode_t*> m_closed;
-	std::vector<bool> m_expanded;
-
-	std::vector<float> m_G;
-	std::vector<float> m_H;
-	std::vector<int> m_smallestCardinality;
-	int m_start;
-	std::vector<int> m_goalSet;
-	std::vector<int> m_targetPoses;
-	std::map<int, int> m_goalmap;
-
-	std::ofstream m_outFile_;
-	bool m_isFailure;
-
-	std::vector<int> m_goalLabels;
-	int m_goalIdxReached;
-	int m_obstaclesCollided;
-	bool m_isPathSuccess;
-	float m_pathCost;
+	friend class SearchCore_t<MCRMostCandidateSolver_t, MCRMCNode_t, MCRMCNode_comparison, BucketOpenList_t<MCRMCNode_t, MCRMCNode_comparison, true>>;
+
+	StampedSet_t m_expanded;
+
+	StampedArray_t<float> m_G;
+	HeuristicMode_t m_heuristic;
+	GoalHeuristic_t m_H;
+	StampedArray_t<int> m_smallestCardinality;
 
 	std::vector<int> m_mostPromisingLabels;
 
+	// search policies (see SearchCore.hpp)
+	bool isDominated(const MCRMCNode_t *n) { return m_expanded[n->m_id]; }
+	void close(const MCRMCNode_t *n) { m_expanded.insert(n->m_id); }
+	void relax(const Graph_t &g, const MCRMCNode_t *current, int currentIdx, int neighbor, int e);
+
 public:
-	MCRMostCandidateSolver_t(Graph_t &g, int start, std::vector<int> goalSet);
-	~MCRMostCandidateSolver_t();
-
-	void computeH(Graph_t &g);
-	void MCRMCGreedy_search(Graph_t &g);
-	void back_track_path();
-	void pathToTrajectory(Graph_t &g);
-	void writeTrajectory(std::string trajectory_file);
-	void printLabels();
-	void print_path();
-	void print_cost();
-	void print_goalIdxReached();
-	void printAll();
-	
-	std::vector<int> label_union(std::vector<int> s1, std::vector<int> s2);
-
-	// harvest the results
-	void checkPathSuccess(int nhypo);
-
-	// getters
-	std::vector<std::vector<float>> getTrajectory() {return m_trajectory;}
-	bool getFailureIndicator() {return m_isFailure;}
-	int getObstaclesCollided() {return m_obstaclesCollided;}
-	bool getIsPathSuccess() {return m_isPathSuccess;}
-	float getPathCost() {return m_pathCost;}
+	// heuristic: which h to use (see Heuristic.hpp)
+	MCRMostCandidateSolver_t(const Graph_t &g, int start, std::vector<int> goalSet, 
+										HeuristicMode_t heuristic = HEURISTIC_GOALMEAN);
+	// start over with another query on the same graph and heuristic mode, reusing the
+	// buffers: costs the previous search, not the size of the graph
+	void reset(const Graph_t &g, int start, std::vector<int> goalSet);
+
+	void computeH(const Graph_t &g, HeuristicMode_t heuristic = HEURISTIC_GOALMEAN);
+	void MCRMCGreedy_search(const Graph_t &g);
 };
 
 
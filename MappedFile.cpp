@@ -0,0 +1,47 @@
+/* This cpp file defines a read-only memory mapping of a whole file,
+used to load binary roadmaps in place */
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "MappedFile.hpp"
+
+bool MappedFile_t::open(std::string file)
+{
+	close();
+	int fd = ::open(file.c_str(), O_RDONLY);
+	if (fd == -1) { return false; }
+	struct stat st;
+	if (fstat(fd, &st) == -1)
+	{
+		::close(fd);
+		return false;
+	}
+	if (st.st_size == 0)
+	{
+		// an empty file cannot be mapped, but it is a valid (empty) file
+		::close(fd);
+		m_data = "";
+		m_size = 0;
+		return true;
+	}
+	void *p = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	// the mapping stays valid after the descriptor is closed
+	::close(fd);
+	if (p == MAP_FAILED) { return false; }
+	m_data = static_cast<const char*>(p);
+	m_size = st.st_size;
+	return true;
+}
+
+void MappedFile_t::close()
+{
+	if (m_data != nullptr)
+	{
+		if (m_size > 0) { munmap(const_cast<char*>(m_data), m_size); }
+		m_data = nullptr;
+		m_size = 0;
+	}
+}
@@ -0,0 +1,34 @@
+/* This hpp file declares a read-only memory mapping of a whole file,
+used to load binary roadmaps in place */
+
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <string>
+#include <cstddef>
+
+class MappedFile_t
+{
+	const char *m_data;
+	std::size_t m_size;
+
+public:
+	// Constructor
+	MappedFile_t() : m_data(nullptr), m_size(0) {}
+	MappedFile_t(const MappedFile_t&) = delete;
+	MappedFile_t& operator=(const MappedFile_t&) = delete;
+
+	// map the file (returns false if it cannot be opened or mapped)
+	bool open(std::string file);
+	void close();
+
+	// getters
+	bool isOpen() const { return m_data != nullptr; }
+	const char* data() const { return m_data; }
+	std::size_t size() const { return m_size; }
+
+	// Destructor
+	~MappedFile_t() { close(); }
+};
+
+#endif
@@ -18,203 +18,145 @@ with specified start and goal set */
 #include "MaxSuccessExactSolver.hpp"
 #include "Timer.hpp"
 
-MaxSuccessExactSolver_t::MaxSuccessExactSolver_t(Graph_t &g)
+MaxSuccessExactSolver_t::MaxSuccessExactSolver_t(const Graph_t &g, bool deltaLabels, HeuristicMode_t heuristic)
+											: m_heuristic(heuristic)
+{
+	m_labelSets.build(g, deltaLabels);
+	reset(g, g.getStart(), g.getGoalSet());
+}
+
+void MaxSuccessExactSolver_t::reset(const Graph_t &g, int start, std::vector<int> goalSet)
 {
 	// initialize the start & goalSet
-	m_start = g.getStart();
-	m_goalSet = g.getGoalSet();
-	m_targetPoses = g.getTargetPoses();
-	for (int i=0; i < m_goalSet.size(); i++)
+	init_goals(g, start, goalSet);
+	for (int ii=0; ii < m_goalSet.size(); ii++)
 	{
-		m_goalmap[m_goalSet[i]] = m_targetPoses[i];
+		if (m_targetPoses[ii] < 0)
+		{
+			std::cerr << "Goal " << m_goalSet[ii] << " is not a goal of the graph, it has no target pose\n";
+			exit(1);
+		}
 	}
-	m_labelWeights = g.getLabelWeights();
-	m_nobstacles = countObs();
-	computeGoalMean(g); // heuristics
+	// keep the label representation picked by the constructor
+	m_labelSets.build(g, m_labelSets.isDelta());
+	m_labelWeightsVersion = g.getLabelWeightsVersion();
+	computeGoalMean(g, m_heuristic); // heuristics
 	std::vector<int> temp_goalIdxes = m_goalhypos; // for the start, all the goals are available
 	 
-	m_open.push( new MaxSuccExactNode_t(m_start, 0.0, computeH(g.getState(m_start), temp_goalIdxes), 
-		{}, computeSurvival({}), temp_goalIdxes, computeReach(temp_goalIdxes), false, nullptr) );
-	m_visited = std::vector<bool>(g.getnNodes(), false);
-	m_visited[m_start] = true;
-	int n_nodes = g.getnNodes();
-	for (int hh=0; hh < n_nodes; hh++)
-	{
-		m_recordSet.push_back(std::vector<std::vector<int>>());
-	}
-
-	m_isFailure = false;
-
+	m_open.push( m_start, m_nodes.create(m_start, 0.0, computeH(g, m_start, temp_goalIdxes), 
+		m_labelSets.emptySet(), computeSurvival(g, m_labelSets.emptySet()), temp_goalIdxes, computeReach(g, temp_goalIdxes), false, -1) );
+	m_visited.init(g.getnNodes());
+	m_visited.insert(m_start);
+	m_recordSet.init(g.getnNodes(), std::vector<int>());
 }
 
-MaxSuccessExactSolver_t::~MaxSuccessExactSolver_t()
+void MaxSuccessExactSolver_t::MSExact_search(const Graph_t &g)
 {
-	while (!m_open.empty())
+	// the survival and the reach of the start node are stale if the weights changed
+	if (m_labelWeightsVersion != g.getLabelWeightsVersion())
 	{
-		MaxSuccExactNode_t* a1 = m_open.top();
-		delete a1;
-		m_open.pop();
+		reset(g, m_start, m_goalSet);
 	}
-	for (auto &e : m_closed) { delete e; }
+	search(g);
 }
 
-
-void MaxSuccessExactSolver_t::MSExact_search(Graph_t &g)
+void MaxSuccessExactSolver_t::relax(const Graph_t &g, const MaxSuccExactNode_t *current, int currentIdx, int neighbor, int e)
 {
+	float edgeCost = g.getEdgeCostById(e);
+	ConstRange_t<int> edgeLabels = g.getEdgeLabelsById(e);
+	// check the path to neighbors: labels, survival and goalIdxes
+	int neighborLabels = m_labelSets.unite(current->m_labels, g, e);
+	float neighborSurvival = computeSurvival(g, neighborLabels);
+	std::vector<int> neighbor_goalIdxes = update_goalIdxes(current->m_goalIndexes, edgeLabels);
 	float neighbor_g;
-	float neighborSurvival;
-	std::vector<int> neighbor_goalIdxes;
 	float neighbor_h;
 	float neighbor_reachability;
 
-	while (!m_open.empty())
-	{
-		MaxSuccExactNode_t *current = m_open.top();
-		m_open.pop();
+	// check whether we need to put this neighbor into the priority queue (based on labels)
+	// Every time we look at a neighbor, check if the labels it carries
+	// is a super set of any of the set in the m_recordSet ( except for the first time :) )
 
-		m_closed.push_back(current);
-		if (current->m_isGoal == true)
-		{
-			std::cout << "Goal is connected all the way to the start\n";
-			back_track_path(); // construct your path
-			pathToTrajectory(g);
-			m_goalLabels = current->m_labels;
-			// printLabels();		
-			// print the pose the goal indicates
-			m_goalIdxReached = m_goalmap[current->m_id];
-			m_pathCost = current->m_f;
-			// std::cout << "The reaching target pose is: " << m_goalIdxReached << "\n";
-			// print the survivability, reachability and success value for the goal
-			// std::cout << "survival: " << current->m_survival << ", reachable: " 
-			// 		<< current->m_reachability << ", success: " << current->m_successValue << "\n";
-			// std::cout << "The cost: " << m_pathCost << "\n";
-
-			return;
-		}
-		// If it is not the goal, let's keep moving
-		// look at each neighbor of the current node
-		std::vector<int> neighbors = g.getNodeNeighbors(current->m_id);
-		for (auto const &neighbor : neighbors)
-		{
-			// check the path to neighbors: labels, survival and goalIdxes
-			std::vector<int> neighborLabels = 
-				label_union(current->m_labels, g.getEdgeLabels(current->m_id, neighbor));
-			neighborSurvival = computeSurvival(neighborLabels);
-			neighbor_goalIdxes = update_goalIdxes(current->m_goalIndexes, 
-											g.getEdgeLabels(current->m_id, neighbor));
-
-			// check whether we need to put this neighbor into the priority queue (based on labels)
-			// Every time we look at a neighbor, check if the labels it carries
-			// is a super set of any of the set in the m_recordSet ( except for the first time :) )
-
-			// The first time visited 
-			if (m_visited[neighbor] == false)
-			{
-				// compute several attributes and then add to the open list
-				neighbor_g = current->m_g + g.getEdgeCost(current->m_id, neighbor);
-				neighbor_h = computeH(g.getState(neighbor), neighbor_goalIdxes);
-				neighbor_reachability = computeReach(neighbor_goalIdxes);
+	// The first time visited 
+	if (m_visited[neighbor] == false)
+	{
+		// compute several attributes and then add to the open list
+		neighbor_g = current->m_g + edgeCost;
+		neighbor_h = computeH(g, neighbor, neighbor_goalIdxes);
+		neighbor_reachability = computeReach(g, neighbor_goalIdxes);
 
-				// now put it to the open list
-				m_open.push( new MaxSuccExactNode_t(neighbor, neighbor_g, neighbor_h, neighborLabels, 
-					neighborSurvival, neighbor_goalIdxes, neighbor_reachability, false, current) );
-				m_recordSet[neighbor].push_back(neighborLabels);
-				m_visited[neighbor] = true;
+		// now put it to the open list
+		m_open.push( neighbor, m_nodes.create(neighbor, neighbor_g, neighbor_h, neighborLabels, 
+			neighborSurvival, neighbor_goalIdxes, neighbor_reachability, false, currentIdx) );
+		m_recordSet.at(neighbor).push_back(neighborLabels);
+		m_visited.insert(neighbor);
 
 
-				/// check if it is a goal node ///
-				if ( std::find(m_goalSet.begin(), m_goalSet.end(), neighbor) != m_goalSet.end() )
-				{
-					if ( std::find(neighbor_goalIdxes.begin(), neighbor_goalIdxes.end(), 
-												m_goalmap[neighbor]) == neighbor_goalIdxes.end() )
-					{
-						// it is a goal node, but it does not mean that it is a goal if the 
-						// neighbor_goalIdxes does not contain the goal the goal node is associated
-						// with, it is NOT a goal
-						continue;
-					}
-					// Now it's a goal. You need to make another copy of the node denote as 
-					// a goal node, instead of an intermediate node. Add it to the open list as well
-					m_open.push( new MaxSuccExactNode_t(neighbor, neighbor_g, 0.0, neighborLabels, 
-								neighborSurvival, std::vector<int>(1, m_goalmap[neighbor]), 
-									m_labelWeights[m_goalmap[neighbor]].second, true, current) );
-				}
-
-			}
-			else // not the first time visited
+		/// check if it is a goal node ///
+		if ( m_goalTable->isGoal(neighbor) )
+		{
+			if ( std::find(neighbor_goalIdxes.begin(), neighbor_goalIdxes.end(), 
+										m_goalTable->getTargetPose(neighbor)) == neighbor_goalIdxes.end() )
 			{
-				// check if the label set is a super set of any set that 
-				// we have seen before in m_recordSet
-				if (!check_superset(neighbor, neighborLabels))
-				{
-					// You reach the same node again with a different set (not a super set)
-					// let's put it in the open list
-					// again lots of things to compute before adding to the open list
-					neighbor_g = current->m_g + g.getEdgeCost(current->m_id, neighbor);
-					neighborSurvival = computeSurvival(neighborLabels);
-
-					neighbor_goalIdxes = update_goalIdxes(current->m_goalIndexes, 
-													g.getEdgeLabels(current->m_id, neighbor));
-					neighbor_h = computeH(g.getState(neighbor), neighbor_goalIdxes);
-					neighbor_reachability = computeReach(neighbor_goalIdxes);
-
-					// now put it to the open list
-					m_open.push( new MaxSuccExactNode_t(neighbor, neighbor_g, neighbor_h, 
-									neighborLabels, neighborSurvival, neighbor_goalIdxes, 
-														neighbor_reachability, false, current) );
-					m_recordSet[neighbor].push_back(neighborLabels);
-
-					/// check if it is a goal node ///
-					if ( std::find(m_goalSet.begin(), m_goalSet.end(), neighbor) != m_goalSet.end() )
-					{
-						if ( std::find(neighbor_goalIdxes.begin(), neighbor_goalIdxes.end(), 
-													m_goalmap[neighbor]) == neighbor_goalIdxes.end() )
-						{
-							// it is a goal node, but it does not mean that it is a goal if the 
-							// neighbor_goalIdxes does not contain the goal the goal node is associated
-							// with, it is NOT a goal
-							continue;
-						}
-						// Now it's a goal. You need to make another copy of the node denote as 
-						// a goal node, instead of an intermediate node. Add it to the open list as well
-						m_open.push( new MaxSuccExactNode_t(neighbor, neighbor_g, 0.0, 
-								neighborLabels, neighborSurvival, 
-										std::vector<int>(1, m_goalmap[neighbor]), 
-											m_labelWeights[m_goalmap[neighbor]].second, true, current) );
-					}
-
-				}
+				// it is a goal node, but it does not mean that it is a goal if the 
+				// neighbor_goalIdxes does not contain the goal the goal node is associated
+				// with, it is NOT a goal
+				return;
 			}
-
+			// Now it's a goal. You need to make another copy of the node denote as 
+			// a goal node, instead of an intermediate node. Add it to the open list as well
+			m_open.push( g.getnNodes()+m_goalTable->getGoalSlot(neighbor), m_nodes.create(neighbor, neighbor_g, 0.0, neighborLabels, 
+						neighborSurvival, std::vector<int>(1, m_goalTable->getTargetPose(neighbor)), 
+							g.getSingleWeight(m_goalTable->getTargetPose(neighbor)), true, currentIdx) );
 		}
-	}
-	// You are reaching here since the open list is empty and the goal is not found
-	std::cout << "The problem is not solvable. Search failed...\n";
-	m_isFailure = true;
-}
 
-void MaxSuccessExactSolver_t::checkPathSuccess(int nhypo)
-{
-	m_obstaclesCollided = 0;
-	m_isPathSuccess = true;
-	// compute the obstacles collided
-	// loop through the m_goalLabels
-	for (auto const &l : m_goalLabels)
+	}
+	else // not the first time visited
 	{
-		if (l % nhypo == 0)
+		// check if the label set is a super set of any set that 
+		// we have seen before in m_recordSet
+		if (!check_superset(neighbor, neighborLabels))
 		{
-			m_obstaclesCollided += 1;
+			// You reach the same node again with a different set (not a super set)
+			// let's put it in the open list
+			// again lots of things to compute before adding to the open list
+			neighbor_g = current->m_g + edgeCost;
+			neighborSurvival = computeSurvival(g, neighborLabels);
+
+			neighbor_goalIdxes = update_goalIdxes(current->m_goalIndexes, edgeLabels);
+			neighbor_h = computeH(g, neighbor, neighbor_goalIdxes);
+			neighbor_reachability = computeReach(g, neighbor_goalIdxes);
+
+			// now put it to the open list
+			m_open.push( neighbor, m_nodes.create(neighbor, neighbor_g, neighbor_h, 
+							neighborLabels, neighborSurvival, neighbor_goalIdxes, 
+												neighbor_reachability, false, currentIdx) );
+			m_recordSet.at(neighbor).push_back(neighborLabels);
+
+			/// check if it is a goal node ///
+			if ( m_goalTable->isGoal(neighbor) )
+			{
+				if ( std::find(neighbor_goalIdxes.begin(), neighbor_goalIdxes.end(), 
+											m_goalTable->getTargetPose(neighbor)) == neighbor_goalIdxes.end() )
+				{
+					// it is a goal node, but it does not mean that it is a goal if the 
+					// neighbor_goalIdxes does not contain the goal the goal node is associated
+					// with, it is NOT a goal
+					return;
+				}
+				// Now it's a goal. You need to make another copy of the node denote as 
+				// a goal node, instead of an intermediate node. Add it to the open list as well
+				m_open.push( g.getnNodes()+m_goalTable->getGoalSlot(neighbor), m_nodes.create(neighbor, neighbor_g, 0.0, 
+						neighborLabels, neighborSurvival, 
+								std::vector<int>(1, m_goalTable->getTargetPose(neighbor)), 
+									g.getSingleWeight(m_goalTable->getTargetPose(neighbor)), true, currentIdx) );
+			}
+
 		}
 	}
-	if (m_obstaclesCollided != 0 or m_goalIdxReached != 0)
-	{
-		m_isPathSuccess = false;
-	}
-
 }
 
-std::vector<int> MaxSuccessExactSolver_t::update_goalIdxes(std::vector<int> currGoalIndexes, 
-																		std::vector<int> edgelabels)
+std::vector<int> MaxSuccessExactSolver_t::update_goalIdxes(const std::vector<int> &currGoalIndexes, 
+																		ConstRange_t<int> edgelabels)
 {
 	std::vector<int> newGoalIndexes;
 	// loop through all current goal indexes
@@ -230,93 +172,66 @@ std::vector<int> MaxSuccessExactSolver_t::update_goalIdxes(std::vector<int> curr
 }
 
 
-int MaxSuccessExactSolver_t::countObs()
-{
-	int maxIdx = -1;
-	int tempIdx;
-	for (int ii=0; ii < m_labelWeights.size(); ii++)
-	{
-		tempIdx = m_labelWeights[ii].first;
-		if (maxIdx < tempIdx)
-		{
-			maxIdx = tempIdx;
-		}
-	}
-	return (maxIdx + 1);
-}
-
-
-void MaxSuccessExactSolver_t::computeGoalMean(Graph_t &g)
+void MaxSuccessExactSolver_t::computeGoalMean(const Graph_t &g, HeuristicMode_t heuristic)
 {
 	// first figure out m_goalhypos (how many unique goal hypos)
-	std::vector<int>::iterator ip;
 	m_goalhypos = m_targetPoses;
 	sort(m_goalhypos.begin(), m_goalhypos.end());
 	m_goalhypos.resize(std::distance(m_goalhypos.begin(), 
 											std::unique(m_goalhypos.begin(), m_goalhypos.end())));
-	// initialization for m_goalCounts and m_goalMean
-	for (int ii=0; ii < m_goalhypos.size(); ii++)
+	// the goals of every goal hypothesis (the vectors of the hypotheses of a previous
+	// query are kept for their buffers)
+	for (auto &hg : m_hypoGoals) { hg.second.clear(); }
+	for (int ii=0; ii < m_goalSet.size(); ii++)
 	{
-		m_goalCounts[m_goalhypos[ii]] = 0;
-		m_goalMean[m_goalhypos[ii]] = std::vector<float>(g.getState(0).size(), 0.0);
+		m_hypoGoals[m_targetPoses[ii]].push_back(m_goalSet[ii]);
 	}
 
-	// loop through all goals and their correpsonding state values into the right category
-	for (int ii=0; ii < m_goalSet.size(); ii++)
+	// their mean
+	m_goalCounts.clear();
+	m_goalMean.clear();
+	for (auto const &gi : m_goalhypos)
 	{
-		std::vector<float> temp_state = g.getState(m_goalSet[ii]);
-		m_goalCounts[m_targetPoses[ii]] += 1;
-		for (int jj=0; jj < temp_state.size(); jj++)
-		{
-			m_goalMean[m_targetPoses[ii]][jj] += temp_state[jj];
-		}
+		m_goalCounts[gi] = m_hypoGoals[gi].size();
+		m_goalMean[gi] = g.getGoalMean(m_hypoGoals[gi]);
 	}
 
-	for (int ii=0; ii < m_goalhypos.size(); ii++)
+	// the heuristic to the goals of every goal hypothesis. The eager goal mean and the
+	// cost-to-go tables are shared through the graph, so a goal subset seen before
+	// costs no pass over the nodes
+	m_heuristic = heuristic;
+	for (auto const &gi : m_goalhypos)
 	{
-		for (int jj=0; jj < m_goalMean[ii].size(); jj++)
-		{
-			m_goalMean[ii][jj] /= m_goalCounts[ii];
-		}
+		m_hypoGoalTables[gi].build(g.getnNodes(), m_hypoGoals[gi], 
+										std::vector<int>(m_hypoGoals[gi].size(), gi));
+		m_hypoH[gi].build(g, m_hypoGoals[gi], m_hypoGoalTables[gi], m_heuristic);
 	}
-
 }
 
-float MaxSuccessExactSolver_t::computeH(std::vector<float> temp_state, std::vector<int> goalIdxes)
+float MaxSuccessExactSolver_t::computeH(const Graph_t &g, int node, const std::vector<int> &goalIdxes)
 {
-	// Initialize temp_hs
-	std::map<int, float> temp_hs;
-	for (auto const &gi : goalIdxes)
-	{
-		temp_hs[gi] = 0.0;
-	}
-	// fill in temp_hs
+	// compute the weighted heurisitic (goalIdxes are sorted and unique)
+	float temp_h = 0.0;
 	for (auto const &gi : goalIdxes)
 	{
-		for (int qq=0; qq < temp_state.size(); qq++)
+		// no term for a hypothesis whose goals cannot be reached from the node (cost-to-go)
+		float h = m_hypoH[gi][node];
+		if (h != std::numeric_limits<float>::infinity())
 		{
-			temp_hs[gi] += pow(temp_state[qq] - m_goalMean[gi][qq], 2);
+			temp_h += h * g.getSingleWeight(gi);
 		}
-
-	}
-	// compute the weighted heurisitic
-	float temp_h = 0.0;
-	for (auto const &th : temp_hs)
-	{
-		temp_h += sqrt(th.second) * m_labelWeights[th.first].second;
 	}
 
 	return temp_h;
 }
 
-float MaxSuccessExactSolver_t::computeSurvival(std::vector<int> labels)
+float MaxSuccessExactSolver_t::computeSurvival(const Graph_t &g, int labels)
 {
 	float survival = 1.0;
-	std::vector<float> CollisionPerObs(m_nobstacles, 0.0);
-	for (auto const &label : labels)
-	{
-		CollisionPerObs[m_labelWeights[label].first] += m_labelWeights[label].second;
-	}
+	std::vector<float> CollisionPerObs(g.getnObstacles(), 0.0);
+	m_labelSets.get(labels).forEach([&](int label) {
+		CollisionPerObs[g.getLabelObstacle(label)] += g.getSingleWeight(label);
+	});
 	// compute survival based on CollisionPerObs
 	for (auto const &collision_prob : CollisionPerObs)
 	{
@@ -326,13 +241,13 @@ float MaxSuccessExactSolver_t::computeSurvival(std::vector<int> labels)
 	return survival;
 }
 
-float MaxSuccessExactSolver_t::computeReach(std::vector<int> goalIdxes)
+float MaxSuccessExactSolver_t::computeReach(const Graph_t &g, const std::vector<int> &goalIdxes)
 {
 	float MaxReach = 0.0;
 	float temp_reach;
 	for (auto const &gi : goalIdxes)
 	{
-		temp_reach = m_labelWeights[gi].second;
+		temp_reach = g.getSingleWeight(gi);
 		if (MaxReach < temp_reach)
 		{
 			MaxReach = temp_reach;
@@ -342,66 +257,11 @@ float MaxSuccessExactSolver_t::computeReach(std::vector<int> goalIdxes)
 	return MaxReach;
 }
 
-void MaxSuccessExactSolver_t::print_path()
-{
-	// print the path for checking purpose
-	std::cout << "path: \n";
-	for (auto const &waypoint : m_path)
-	{
-		std::cout << waypoint << " ";
-	}
-	std::cout << "\n";
-}
-
-void MaxSuccessExactSolver_t::printLabels()
-{
-	std::cout << "labels: " << "< ";
-	for (auto const &l : m_goalLabels)
-	{
-		std::cout << l << " ";
-	}
-	std::cout << ">\n";	
-}
-
-void MaxSuccessExactSolver_t::print_cost()
-{
-	std::cout << "cost: " << m_pathCost << "\n";
-}
 		
-void MaxSuccessExactSolver_t::print_goalIdxReached()
-{
-	std::cout << "The reaching target pose is: " << m_goalIdxReached << "\n";
-}
-
-void MaxSuccessExactSolver_t::printAll()
-{
-	print_path();
-	print_cost();
-	printLabels();
-	print_goalIdxReached();
-}
-
-std::vector<int> MaxSuccessExactSolver_t::label_union(std::vector<int> s1, std::vector<int> s2)
-{
-	// sort the sets first before applying union operation
-	std::sort(s1.begin(), s1.end());
-	std::sort(s2.begin(), s2.end());
-
-	// Declaring resultant vector for union
-	std::vector<int> v(s1.size()+s2.size());
-	// using function set_union() to compute union of 2
-	// containers v1 and v2 and store result in v
-	auto it = std::set_union(s1.begin(), s1.end(), s2.begin(), s2.end(), v.begin());
-
-	// resizing new container
-	v.resize(it - v.begin());
-	return v;	
-}
-
-bool MaxSuccessExactSolver_t::check_superset(int neighbor, std::vector<int> neighborLabels)
+bool MaxSuccessExactSolver_t::check_superset(int neighbor, int neighborLabels)
 {
 	bool isSuperset = false;
-	for (auto const s: m_recordSet[neighbor])
+	for (auto const &s: m_recordSet[neighbor])
 	{
 		if ( check_subset(neighborLabels, s) ) { return true; }
 	}
@@ -409,71 +269,12 @@ bool MaxSuccessExactSolver_t::check_superset(int neighbor, std::vector<int> neig
 	return isSuperset;
 }
 
-bool MaxSuccessExactSolver_t::check_subset(std::vector<int> set, std::vector<int> subset)
+bool MaxSuccessExactSolver_t::check_subset(int set, int subset)
 {
 	// This function check whether a input set of labels is a subset of the m_currentLabels
-	return ( std::includes(set.begin(), set.end(), subset.begin(), subset.end()) );	
-}
-
-
-void MaxSuccessExactSolver_t::back_track_path()
-{
-	// start from the goal
-	MaxSuccExactNode_t *current = m_closed[m_closed.size()-1];
-	while (current->m_id != m_start)
-	{
-		// keep backtracking the path until you reach the start
-		m_path.push_back(current->m_id);
-		current = current->m_parent;
-	}
-	// finally put the start into the path
-	m_path.push_back(current->m_id);
-
-	// print the path for checking purpose
-	// std::cout << "path: \n";
-	// for (auto const &waypoint : m_path)
-	// {
-	// 	std::cout << waypoint << " ";
-	// }
-	// std::cout << "\n";
-}
-
-void MaxSuccessExactSolver_t::pathToTrajectory(Graph_t &g)
-{
-	// start from the start
-	for (int i=m_path.size()-1; i >=0; i--)
-	{
-		m_trajectory.push_back(g.getState(m_path[i]));
-
-	}
-	// // print the trajectory for checking purpose
-	// std::cout << "The trajectory: \n";
-	// for (auto const &t : m_trajectory)
-	// {
-	// 	for (auto const &d : t)
-	// 	{
-	// 		std::cout << d << "   ";
-	// 	}
-	// 	std::cout << "\n";
-	// }
+	return m_labelSets.includes(set, subset);
 }
 
-void MaxSuccessExactSolver_t::writeTrajectory(std::string trajectory_file)
-{
-	m_outFile_.open(trajectory_file);
-	if (m_outFile_.is_open())
-	{
-		for (auto const &t : m_trajectory)
-		{
-			for (auto const &d : t)
-			{
-				m_outFile_ << d << " ";
-			}
-			m_outFile_ << "\n";
-		}
-	}
-	m_outFile_.close();
-}
 
 void MaxSuccessExactSolver_t::printToVerify()
 {
@@ -493,9 +294,12 @@ void MaxSuccessExactSolver_t::printToVerify()
 
 	// then print m_goalmap
 	std::cout << "_________m_goalmap_________\n";
-	for (auto const &gm : m_goalmap)
+	std::vector<int> temp_goals = m_goalSet;
+	std::sort(temp_goals.begin(), temp_goals.end());
+	temp_goals.erase(std::unique(temp_goals.begin(), temp_goals.end()), temp_goals.end());
+	for (auto const &goal : temp_goals)
 	{
-		std::cout << gm.first << ": " << gm.second << "\n";
+		std::cout << goal << ": " << m_goalTable->getTargetPose(goal) << "\n";
 	}
 
 	// print out m_goalhypos and m_goalCounts
@@ -11,6 +11,9 @@ with specified start and goal set */
 #include <map>
 
 #include "Graph.hpp"
+#include "SearchCore.hpp"
+#include "Heuristic.hpp"
+#include "StampedArray.hpp"
 
 struct MaxSuccExactNode_t
 {
@@ -18,10 +21,9 @@ struct MaxSuccExactNode_t
 	float m_g;
 	float m_h;
 	float m_f;
-	// label and survivability
-	std::vector<int> m_labels;
+	// label set and survivability
+	int m_labels; // id of the label set in the search's LabelSetTable_t
 	float m_survival; // total survivability of labels
-	int m_labelCardinality;
 
 	//goal uncertainty
 	std::vector<int> m_goalIndexes;
@@ -29,10 +31,10 @@ struct MaxSuccExactNode_t
 	float m_successValue;
 	bool m_isGoal;
 
-	MaxSuccExactNode_t *m_parent;
+	int m_parent; // index of the parent in the node pool, -1 for the start
 
-	MaxSuccExactNode_t(int id, float g, float h, std::vector<int> labels, float survival, 
-		std::vector<int> goalIdxes, float reachability, bool isGoal, MaxSuccExactNode_t *parent)
+	MaxSuccExactNode_t(int id, float g, float h, int labels, float survival, 
+		std::vector<int> goalIdxes, float reachability, bool isGoal, int parent)
 	{
 		m_id = id;
 		m_g = g;
@@ -40,7 +42,6 @@ struct MaxSuccExactNode_t
 		m_f = m_g + m_h;
 		m_labels = labels;
 		m_survival = survival;
-		m_labelCardinality = m_labels.size();
 		m_goalIndexes = goalIdxes;
 		m_reachability = reachability;
 		m_successValue = m_survival * m_reachability;
@@ -68,77 +69,60 @@ struct MaxSuccExactNode_comparison
 };
 
 
-class MaxSuccessExactSolver_t
+class MaxSuccessExactSolver_t : public SearchCore_t<MaxSuccessExactSolver_t, MaxSuccExactNode_t, MaxSuccExactNode_comparison>
 {
-	std::vector<int> m_path;
-	std::vector<std::vector<float>> m_trajectory;
+	friend class SearchCore_t<MaxSuccessExactSolver_t, MaxSuccExactNode_t, MaxSuccExactNode_comparison>;
 
-	std::priority_queue<MaxSuccExactNode_t*, std::vector<MaxSuccExactNode_t*>, 
-													MaxSuccExactNode_comparison> m_open;
-	std::vector<MaxSuccExactNode_t*> m_closed;
-	std::vector<bool> m_visited;
-	std::vector<std::vector<std::vector<int>>> m_recordSet;
+	StampedSet_t m_visited;
+	StampedArray_t<std::vector<int>> m_recordSet;
 
 	// No m_G: since we are not keep tracking the g-value for the best recorded node since we allow
 	//         the same node to be expanded multiple times
 	// Dynamic m_H: The heuristics are changing depending on the goals the path from start to 
 	// that node aims at.
-	int m_start;
-
-	std::vector<int> m_goalSet;
-	std::vector<int> m_targetPoses;
-	std::map<int, int> m_goalmap;
 
 	std::vector<int> m_goalhypos;
+	// the goals of every goal hypothesis and their mean (see printToVerify)
 	std::map<int, int> m_goalCounts;
 	std::map<int, std::vector<float>> m_goalMean;
+	// the goals of every goal hypothesis, their goal table and the heuristic to them
+	// (see Heuristic.hpp), kept from one reset to the next for their buffers
+	HeuristicMode_t m_heuristic;
+	std::map<int, std::vector<int>> m_hypoGoals;
+	std::map<int, GoalTable_t> m_hypoGoalTables;
+	std::map<int, GoalHeuristic_t> m_hypoH;
 
-	std::map<int, std::pair<int, float>> m_labelWeights;
-	int m_nobstacles;
-
-	std::ofstream m_outFile_;
-	bool m_isFailure;
+	// the label weights are read from the graph, which may update them between queries:
+	// the version they had when the start node was made (see Graph_t::setLabelWeight)
+	std::uint64_t m_labelWeightsVersion;
 
-	std::vector<int> m_goalLabels;
-	int m_goalIdxReached;
-	int m_obstaclesCollided;
-	bool m_isPathSuccess;
-	float m_pathCost;
+	// search policies (see SearchCore.hpp)
+	bool isGoal(const MaxSuccExactNode_t *n) { return n->m_isGoal; }
+	void relax(const Graph_t &g, const MaxSuccExactNode_t *current, int currentIdx, int neighbor, int e);
 
 public:
-	MaxSuccessExactSolver_t(Graph_t &g);
-	~MaxSuccessExactSolver_t();
-
-	std::vector<int> update_goalIdxes(std::vector<int> currGoalIndexes, std::vector<int> edgelabels);	
-
-	int countObs();
-	void computeGoalMean(Graph_t &g);
-	float computeH(std::vector<float> temp_state, std::vector<int> goalIdxes);
-	float computeSurvival(std::vector<int> labels);
-	float computeReach(std::vector<int> goalIdxes); // the highest reachability among available goals
-	void MSExact_search(Graph_t &g);
-	void back_track_path();
-	void pathToTrajectory(Graph_t &g);
-	void writeTrajectory(std::string trajectory_file);
-	void printLabels();
-	void print_path();
-	void print_cost();
-	void print_goalIdxReached();
-	void printAll();
-
-	std::vector<int> label_union(std::vector<int> s1, std::vector<int> s2);
-	bool check_superset(int, std::vector<int>);	
-	bool check_subset(std::vector<int>, std::vector<int>);
-
-	// harvest the results
-	void checkPathSuccess(int nhypo);
-
-	// getters
-	std::vector<std::vector<float>> getTrajectory() {return m_trajectory;}
-	bool getFailureIndicator() {return m_isFailure;}
-	int getObstaclesCollided() {return m_obstaclesCollided;}
-	bool getIsPathSuccess() {return m_isPathSuccess;}
-	float getPathCost() {return m_pathCost;}
+	// deltaLabels: keep the label sets as parent deltas (see LabelSet.hpp), less memory
+	// on long searches for some more time per dominance check
+	// heuristic: which h to use to the goals of every goal hypothesis (see Heuristic.hpp)
+	MaxSuccessExactSolver_t(const Graph_t &g, bool deltaLabels = false, HeuristicMode_t heuristic = HEURISTIC_GOALMEAN);
+	// start over with another query on the same graph, label representation and heuristic
+	// mode, reusing the buffers. The goals must be goals of the graph (for their target
+	// poses). It costs the previous search, not the size of the graph, except for the
+	// first eager goal mean or cost-to-go table of a goal subset (shared through the graph)
+	void reset(const Graph_t &g, int start, std::vector<int> goalSet);
+
+	std::vector<int> update_goalIdxes(const std::vector<int> &currGoalIndexes, 
+															ConstRange_t<int> edgelabels);	
+
+	void computeGoalMean(const Graph_t &g, HeuristicMode_t heuristic = HEURISTIC_GOALMEAN);
+	float computeH(const Graph_t &g, int node, const std::vector<int> &goalIdxes);
+	float computeSurvival(const Graph_t &g, int labels); // labels: id of a label set
+	float computeReach(const Graph_t &g, const std::vector<int> &goalIdxes); // the highest reachability among available goals
+	// a search after the graph updated its label weights starts over on the same query
+	void MSExact_search(const Graph_t &g);
+
+	bool check_superset(int, int);	
+	bool check_subset(int, int);
 
 	// test
 	void printToVerify();
@@ -18,178 +18,213 @@ with specified start and goal set */
 #include "MaxSuccessGreedySolver.hpp"
 #include "Timer.hpp"
 
-MaxSuccessGreedySolver_t::MaxSuccessGreedySolver_t(Graph_t &g)
+MaxSuccessGreedySolver_t::MaxSuccessGreedySolver_t(const Graph_t &g, HeuristicMode_t heuristic)
+											: m_heuristic(heuristic)
+{
+	reset(g, g.getStart(), g.getGoalSet());
+}
+
+void MaxSuccessGreedySolver_t::reset(const Graph_t &g, int start, std::vector<int> goalSet)
 {
 	// initialize the start & goalSet
-	m_start = g.getStart();
-	m_goalSet = g.getGoalSet();
-	m_targetPoses = g.getTargetPoses();
-	for (int i=0; i < m_goalSet.size(); i++)
+	init_goals(g, start, goalSet);
+	for (int ii=0; ii < m_goalSet.size(); ii++)
 	{
-		m_goalmap[m_goalSet[i]] = m_targetPoses[i];
+		if (m_targetPoses[ii] < 0)
+		{
+			std::cerr << "Goal " << m_goalSet[ii] << " is not a goal of the graph, it has no target pose\n";
+			exit(1);
+		}
 	}
-	m_labelWeights = g.getLabelWeights();
-	m_nobstacles = countObs();
-	computeGoalMean(g); // heuristics
+	m_labelSets.build(g);
+	m_labelWeightsVersion = g.getLabelWeightsVersion();
+	computeGoalMean(g, m_heuristic); // heuristics
 	std::vector<int> temp_goalIdxes = m_goalhypos; // for the start, all the goals are available
 
-	m_F = std::vector<float>(g.getnNodes(), std::numeric_limits<float>::max());
-	m_F[m_start] = 0.0 + computeH(g.getState(m_start), temp_goalIdxes);
-
-	for (auto const &gg: m_goalSet)
-	{
-		m_FForGoals[gg] = std::numeric_limits<float>::max();
-		m_highestSuccessForGoals[gg] = -1.0;
-		m_expandedForGoals[gg] = false;
-	}
-	// m_FForGoals = std::vector<float>(m_goalSet.size(), std::numeric_limits<float>::max());
-	m_highestSuccess = std::vector<float>(g.getnNodes(), -1.0);
-	m_highestSuccess[m_start] = computeSurvival({}) * computeReach(temp_goalIdxes);
-	// m_highestSuccessForGoals = std::vector<float>(m_goalSet.size(), -1.0);
-
-	m_open.push( new MaxSuccGreedyNode_t(m_start, 0.0, computeH(g.getState(m_start), temp_goalIdxes), 
-		{}, computeSurvival({}), temp_goalIdxes, computeReach(temp_goalIdxes), false, nullptr) );
+	m_F.init(g.getnNodes(), std::numeric_limits<float>::max());
+	m_F.at(m_start) = 0.0 + computeH(g, m_start, temp_goalIdxes);
 
-	m_expanded = std::vector<bool>(g.getnNodes(), false);
-	// m_expandedForGoals = std::vector<bool>(m_goalSet.size(), false);
+	m_FForGoals = std::vector<float>(m_goalSet.size(), std::numeric_limits<float>::max());
+	m_highestSuccess.init(g.getnNodes(), -1.0);
+	m_highestSuccess.at(m_start) = computeSurvival(g, m_labelSets.emptySet()) * computeReach(g, temp_goalIdxes);
+	m_highestSuccessForGoals = std::vector<float>(m_goalSet.size(), -1.0);
 
-	m_isFailure = false;
+	m_open.push( m_start, m_nodes.create(m_start, 0.0, computeH(g, m_start, temp_goalIdxes), 
+		m_labelSets.emptySet(), computeSurvival(g, m_labelSets.emptySet()), temp_goalIdxes, computeReach(g, temp_goalIdxes), false, -1) );
 
+	m_expanded.init(g.getnNodes());
+	m_expandedForGoals = std::vector<bool>(m_goalSet.size(), false);
 }
 
-MaxSuccessGreedySolver_t::~MaxSuccessGreedySolver_t()
+void MaxSuccessGreedySolver_t::MSGreedy_search(const Graph_t &g)
 {
-	while (!m_open.empty())
+	// the survival and the reach of the start node are stale if the weights changed
+	if (m_labelWeightsVersion != g.getLabelWeightsVersion())
 	{
-		MaxSuccGreedyNode_t* a1 = m_open.top();
-		delete a1;
-		m_open.pop();
+		reset(g, m_start, m_goalSet);
 	}
-	for (auto &e : m_closed) { delete e; }
+	search(g);
 }
 
-void MaxSuccessGreedySolver_t::MSGreedy_search(Graph_t &g)
+void MaxSuccessGreedySolver_t::relax(const Graph_t &g, const MaxSuccGreedyNode_t *current, int currentIdx, int neighbor, int e)
 {
+	float edgeCost = g.getEdgeCostById(e);
+	ConstRange_t<int> edgeLabels = g.getEdgeLabelsById(e);
+	// check neighbor's labels and the survivability
+	int neighborLabels = m_labelSets.unite(current->m_labels, g, e);
+	float neighborSurvival = computeSurvival(g, neighborLabels);	
+	std::vector<int> neighbor_goalIdxes = update_goalIdxes(current->m_goalIndexes, edgeLabels);
 	float neighbor_g;
-	std::vector<int> neighborLabels;
-	float neighborSurvival;
-	std::vector<int> neighbor_goalIdxes;
 	float neighbor_h;
 	float neighbor_reachability;
 	float neighbor_successValue;
-
-	while (!m_open.empty())
+	/// treat it as a normal node first ///
+	// check if the neighbor has been expanded before
+	if (!m_expanded[neighbor])
 	{
-		MaxSuccGreedyNode_t *current = m_open.top();
-		m_open.pop();
+		// get the reachability and the success value
+		neighbor_reachability = computeReach(g, neighbor_goalIdxes);
+		neighbor_successValue = neighborSurvival * neighbor_reachability;
 
-		// Now check if the current node has been expanded
-		// If it is a non-goal node, check m_expanded
-		// If it is a goal node, check m_expandedForGoals
-		if (current->m_isGoal == false and m_expanded[current->m_id] == true)
+		// only add the node if either (1) it has a better successValue or
+		// (2) it has a tied best successValue but with a smaller cost
+		if (neighbor_successValue > m_highestSuccess[neighbor])
 		{
-			// No need to put it into the closed list
-			delete current;
-			continue;
+			// std::cout << "current neighbor: " << neighbor << "\n";
+			m_highestSuccess.at(neighbor) = neighbor_successValue;
+			neighbor_g = current->m_g + edgeCost;
+			// other things to compute before being pushed to open list
+			neighbor_h = computeH(g, neighbor, neighbor_goalIdxes);
+			m_F.at(neighbor) = neighbor_g + neighbor_h;
+			// Now ready to add to open list
+			// std::cout << "start to add the current neighbor into open list\n";
+			m_open.push( neighbor, m_nodes.create(neighbor, neighbor_g, neighbor_h, 
+							neighborLabels, neighborSurvival, neighbor_goalIdxes, 
+												neighbor_reachability, false, currentIdx) );
+			// std::cout << "higher success\n";
+			// std::cout << "add neighbor: " << neighbor << "  " << neighbor_g + neighbor_h << "\n";
+			// std::cout << "[ ";
+			// for (auto const &l: neighborLabels)
+			// {
+			// 	std::cout << l << " ";
+			// }
+			// std::cout << "]  ,";
+			// std::cout << "[ ";
+			// for (auto const &gi : neighbor_goalIdxes)
+			// {
+			// 	std::cout << gi << " ";
+			// }
+			// std::cout << "]\n";
+			// std::cout << neighborSurvival << ", " << neighbor_reachability << ", " 
+			// 				<< neighbor_successValue << ", " << "false" 
+			// 											<< ", " << current->m_id << "\n\n";
 		}
-		if (current->m_isGoal == true and m_expandedForGoals[getIndex(current->m_id)] == true)
+		else if (neighbor_successValue == m_highestSuccess[neighbor])
 		{
-			// No need to put it into the closed list
-			delete current;
-			continue;		
+			// std::cout << "current neighbor: " << neighbor << "\n";
+			neighbor_g = current->m_g + edgeCost;
+			neighbor_h = computeH(g, neighbor, neighbor_goalIdxes);
+			if ( neighbor_g + neighbor_h < m_F[neighbor] )
+			{
+				m_F.at(neighbor) = neighbor_g + neighbor_h;
+				m_open.push( neighbor, m_nodes.create(neighbor, neighbor_g, neighbor_h, 
+								neighborLabels, neighborSurvival, neighbor_goalIdxes, 
+												neighbor_reachability, false, currentIdx) );
+				// std::cout << "tie success\n";
+				// std::cout << "add neighbor: " << neighbor << "  " << neighbor_g + neighbor_h << "\n\n";
+				// std::cout << "[ ";
+				// for (auto const &l: neighborLabels)
+				// {
+				// 	std::cout << l << " ";
+				// }
+				// std::cout << "]  ,";
+				// std::cout << "[ ";
+				// for (auto const &gi : neighbor_goalIdxes)
+				// {
+				// 	std::cout << gi << " ";
+				// }
+				// std::cout << "]\n";
+				// std::cout << neighborSurvival << ", " << neighbor_reachability << ", " 
+				// 				<< neighbor_successValue << ", " << "false" 
+				// 											<< ", " << current->m_id << "\n\n";
+			}
 		}
+		
 
-		// std::cout << "pop out current node: " << current->m_id << "  " << current->m_f << "\n";
-		// std::cout << "[ ";
-		// for (auto const &l: current->m_labels)
-		// {
-		// 	std::cout << l << " ";
-		// }
-		// std::cout << "]  ,";
-		// std::cout << "[ ";
-		// for (auto const &gi : current->m_goalIndexes)
-		// {
-		// 	std::cout << gi << " ";
-		// }
-		// std::cout << "]\n";
-		// if (current->m_parent != nullptr)
-		// {
-		// 	std::cout << current->m_survival << ", " << current->m_reachability << ", " 
-		// 					<< current->m_successValue << ", " << current->m_isGoal 
-		// 												<< ", " << (current->m_parent)->m_id << "\n";
-		// }
-		// else
-		// {
-		// 	std::cout << current->m_survival << ", " << current->m_reachability << ", " 
-		// 					<< current->m_successValue << ", " << current->m_isGoal 
-		// 												<< ", " << "start" << "\n";
-		// }
-
-		// // std::cout << "press any key to continue...\n";
-		// // std::cin.get();
-		m_closed.push_back(current);
-		if (current->m_isGoal == false)
-		{
-			m_expanded[current->m_id] = true;			
-		}
-		else
-		{
-			m_expandedForGoals[getIndex(current->m_id)] = true;
-		}
+	}
 
-		if (current->m_isGoal == true)
+	/// check if it is a goal node ///
+	if ( m_goalTable->isGoal(neighbor) )
+	{
+		int goalSlot = m_goalTable->getGoalSlot(neighbor);
+		if ( std::find(neighbor_goalIdxes.begin(), neighbor_goalIdxes.end(), 
+									m_goalTable->getTargetPose(neighbor)) == neighbor_goalIdxes.end() )
 		{
-			std::cout << "Goal is connected all the way to the start\n";
-			back_track_path(); // construct your path
-			pathToTrajectory(g);
-			m_goalLabels = current->m_labels;
-			// printLabels();	
-			// print the pose the goal indicates
-			m_goalIdxReached = m_goalmap[current->m_id];
-			m_pathCost = current->m_f;
-			// std::cout << "The reaching target pose is: " << m_goalIdxReached << "\n";
-			// print the survivability, reachability and success value for the goal
-			// std::cout << "survival: " << current->m_survival << ", reachable: " 
-			// 		<< current->m_reachability << ", success: " << current->m_successValue << "\n";
-			// std::cout << "The cost: " << m_pathCost << "\n";
-
+			// it is a goal node, but it does not mean that it is a goal if the 
+			// neighbor_goalIdxes does not contain the goal the goal node is associated
+			// with, it is NOT a goal
 			return;
 		}
-		// If it is not the goal, let's keep moving
-		// look at each neighbor of the current node
-		std::vector<int> neighbors = g.getNodeNeighbors(current->m_id);
-		for (auto const &neighbor : neighbors)
+
+		// Now it's time to treat it as a goal node
+		// check if the neighbor has been expanded before
+		if (!m_expandedForGoals[goalSlot])
 		{
-			// check neighbor's labels and the survivability
-			neighborLabels = 
-				label_union(current->m_labels, g.getEdgeLabels(current->m_id, neighbor));
-			neighborSurvival = computeSurvival(neighborLabels);	
-			neighbor_goalIdxes = update_goalIdxes(current->m_goalIndexes, 
-											g.getEdgeLabels(current->m_id, neighbor));
-			/// treat it as a normal node first ///
-			// check if the neighbor has been expanded before
-			if (!m_expanded[neighbor])
+			neighbor_reachability = g.getSingleWeight(m_goalTable->getTargetPose(neighbor));
+			neighbor_successValue = neighborSurvival * neighbor_reachability;
+			// only add the node if either (1) it has a better successValue or
+			// (2) it has a tied best successValue but with a smaller cost
+			if (neighbor_successValue > m_highestSuccessForGoals[goalSlot])
 			{
-				// get the reachability and the success value
-				neighbor_reachability = computeReach(neighbor_goalIdxes);
-				neighbor_successValue = neighborSurvival * neighbor_reachability;
-
-				// only add the node if either (1) it has a better successValue or
-				// (2) it has a tied best successValue but with a smaller cost
-				if (neighbor_successValue > m_highestSuccess[neighbor])
+				m_highestSuccessForGoals[goalSlot] = neighbor_successValue;
+
+				neighbor_g = current->m_g + edgeCost;
+				// other things to compute before being pushed to open list
+				neighbor_h = 0.0;
+				m_FForGoals[goalSlot] = neighbor_g + neighbor_h;
+				// Now ready to add to open list
+				m_open.push( g.getnNodes()+goalSlot, m_nodes.create(neighbor, neighbor_g, neighbor_h, 
+							neighborLabels, neighborSurvival, 
+								std::vector<int>(1, m_goalTable->getTargetPose(neighbor)), 
+											neighbor_reachability, true, currentIdx) );
+				// std::cout << "higher success\n";
+				// std::cout << "add a goal to the open list: " << neighbor << " for pose " 
+				// 			<< m_goalTable->getTargetPose(neighbor) << ": " << neighborSurvival << ", " 
+				// 				<< neighbor_reachability << ", " 
+				// 					<< neighborSurvival * neighbor_reachability << "\n";
+				// std::cout << "add neighbor: " << neighbor << "  " << neighbor_g + neighbor_h << "\n";
+				// std::cout << "[ ";
+				// for (auto const &l: neighborLabels)
+				// {
+				// 	std::cout << l << " ";
+				// }
+				// std::cout << "]  ,";
+				// std::cout << "[ ";
+				// for (auto const &gi : std::vector<int>(1, m_goalTable->getTargetPose(neighbor)))
+				// {
+				// 	std::cout << gi << " ";
+				// }
+				// std::cout << "]\n";
+				// std::cout << neighborSurvival << ", " << neighbor_reachability << ", " 
+				// 				<< neighbor_successValue << ", " << "true" 
+				// 											<< ", " << current->m_id << "\n\n";
+			}
+			else if (neighbor_successValue == m_highestSuccessForGoals[goalSlot])
+			{
+				neighbor_g = current->m_g + edgeCost;
+				neighbor_h = 0.0;
+				if ( neighbor_g + neighbor_h < m_FForGoals[goalSlot] )
 				{
-					// std::cout << "current neighbor: " << neighbor << "\n";
-					m_highestSuccess[neighbor] = neighbor_successValue;
-					neighbor_g = current->m_g + g.getEdgeCost(current->m_id, neighbor);
-					// other things to compute before being pushed to open list
-					neighbor_h = computeH(g.getState(neighbor), neighbor_goalIdxes);
-					m_F[neighbor] = neighbor_g + neighbor_h;
-					// Now ready to add to open list
-					// std::cout << "start to add the current neighbor into open list\n";
-					m_open.push( new MaxSuccGreedyNode_t(neighbor, neighbor_g, neighbor_h, 
-									neighborLabels, neighborSurvival, neighbor_goalIdxes, 
-														neighbor_reachability, false, current) );
-					// std::cout << "higher success\n";
+					m_FForGoals[goalSlot] = neighbor_g + neighbor_h;
+					m_open.push( g.getnNodes()+goalSlot, m_nodes.create(neighbor, neighbor_g, neighbor_h, 
+								neighborLabels, neighborSurvival, 
+									std::vector<int>(1, m_goalTable->getTargetPose(neighbor)), 
+												neighbor_reachability, true, currentIdx) );
+					// std::cout << "tied success\n";
+					// std::cout << "add a goal to the open list: " << neighbor << " for pose " 
+					// 		<< m_goalTable->getTargetPose(neighbor) << ": " << neighborSurvival << ", " 
+					// 			<< neighbor_reachability << ", " 
+					// 				<< neighborSurvival * neighbor_reachability << "\n";
 					// std::cout << "add neighbor: " << neighbor << "  " << neighbor_g + neighbor_h << "\n";
 					// std::cout << "[ ";
 					// for (auto const &l: neighborLabels)
@@ -198,176 +233,25 @@ void MaxSuccessGreedySolver_t::MSGreedy_search(Graph_t &g)
 					// }
 					// std::cout << "]  ,";
 					// std::cout << "[ ";
-					// for (auto const &gi : neighbor_goalIdxes)
+					// for (auto const &gi : std::vector<int>(1, m_goalTable->getTargetPose(neighbor)))
 					// {
 					// 	std::cout << gi << " ";
 					// }
 					// std::cout << "]\n";
 					// std::cout << neighborSurvival << ", " << neighbor_reachability << ", " 
-					// 				<< neighbor_successValue << ", " << "false" 
+					// 				<< neighbor_successValue << ", " << "true" 
 					// 											<< ", " << current->m_id << "\n\n";
 				}
-				else if (neighbor_successValue == m_highestSuccess[neighbor])
-				{
-					// std::cout << "current neighbor: " << neighbor << "\n";
-					neighbor_g = current->m_g + g.getEdgeCost(current->m_id, neighbor);
-					neighbor_h = computeH(g.getState(neighbor), neighbor_goalIdxes);
-					if ( neighbor_g + neighbor_h < m_F[neighbor] )
-					{
-						m_F[neighbor] = neighbor_g + neighbor_h;
-						m_open.push( new MaxSuccGreedyNode_t(neighbor, neighbor_g, neighbor_h, 
-										neighborLabels, neighborSurvival, neighbor_goalIdxes, 
-														neighbor_reachability, false, current) );
-						// std::cout << "tie success\n";
-						// std::cout << "add neighbor: " << neighbor << "  " << neighbor_g + neighbor_h << "\n\n";
-						// std::cout << "[ ";
-						// for (auto const &l: neighborLabels)
-						// {
-						// 	std::cout << l << " ";
-						// }
-						// std::cout << "]  ,";
-						// std::cout << "[ ";
-						// for (auto const &gi : neighbor_goalIdxes)
-						// {
-						// 	std::cout << gi << " ";
-						// }
-						// std::cout << "]\n";
-						// std::cout << neighborSurvival << ", " << neighbor_reachability << ", " 
-						// 				<< neighbor_successValue << ", " << "false" 
-						// 											<< ", " << current->m_id << "\n\n";
-					}
-				}
-				
-
 			}
+	
 
-			/// check if it is a goal node ///
-			if ( std::find(m_goalSet.begin(), m_goalSet.end(), neighbor) != m_goalSet.end() )
-			{
-				if ( std::find(neighbor_goalIdxes.begin(), neighbor_goalIdxes.end(), 
-											m_goalmap[neighbor]) == neighbor_goalIdxes.end() )
-				{
-					// it is a goal node, but it does not mean that it is a goal if the 
-					// neighbor_goalIdxes does not contain the goal the goal node is associated
-					// with, it is NOT a goal
-					continue;
-				}
-
-				// Now it's time to treat it as a goal node
-				// check if the neighbor has been expanded before
-				if (!m_expandedForGoals[neighbor])
-				{
-					neighbor_reachability = m_labelWeights[m_goalmap[neighbor]].second;
-					neighbor_successValue = neighborSurvival * neighbor_reachability;
-					// only add the node if either (1) it has a better successValue or
-					// (2) it has a tied best successValue but with a smaller cost
-					if (neighbor_successValue > m_highestSuccessForGoals[neighbor])
-					{
-						m_highestSuccessForGoals[neighbor] = neighbor_successValue;
-
-						neighbor_g = current->m_g + g.getEdgeCost(current->m_id, neighbor);
-						// other things to compute before being pushed to open list
-						neighbor_h = 0.0;
-						m_FForGoals[neighbor] = neighbor_g + neighbor_h;
-						// Now ready to add to open list
-						m_open.push( new MaxSuccGreedyNode_t(neighbor, neighbor_g, neighbor_h, 
-									neighborLabels, neighborSurvival, 
-										std::vector<int>(1, m_goalmap[neighbor]), 
-													neighbor_reachability, true, current) );
-						// std::cout << "higher success\n";
-						// std::cout << "add a goal to the open list: " << neighbor << " for pose " 
-						// 			<< m_goalmap[neighbor] << ": " << neighborSurvival << ", " 
-						// 				<< neighbor_reachability << ", " 
-						// 					<< neighborSurvival * neighbor_reachability << "\n";
-						// std::cout << "add neighbor: " << neighbor << "  " << neighbor_g + neighbor_h << "\n";
-						// std::cout << "[ ";
-						// for (auto const &l: neighborLabels)
-						// {
-						// 	std::cout << l << " ";
-						// }
-						// std::cout << "]  ,";
-						// std::cout << "[ ";
-						// for (auto const &gi : std::vector<int>(1, m_goalmap[neighbor]))
-						// {
-						// 	std::cout << gi << " ";
-						// }
-						// std::cout << "]\n";
-						// std::cout << neighborSurvival << ", " << neighbor_reachability << ", " 
-						// 				<< neighbor_successValue << ", " << "true" 
-						// 											<< ", " << current->m_id << "\n\n";
-					}
-					else if (neighbor_successValue == m_highestSuccessForGoals[neighbor])
-					{
-						neighbor_g = current->m_g + g.getEdgeCost(current->m_id, neighbor);
-						neighbor_h = 0.0;
-						if ( neighbor_g + neighbor_h < m_FForGoals[neighbor] )
-						{
-							m_FForGoals[neighbor] = neighbor_g + neighbor_h;
-							m_open.push( new MaxSuccGreedyNode_t(neighbor, neighbor_g, neighbor_h, 
-										neighborLabels, neighborSurvival, 
-											std::vector<int>(1, m_goalmap[neighbor]), 
-														neighbor_reachability, true, current) );
-							// std::cout << "tied success\n";
-							// std::cout << "add a goal to the open list: " << neighbor << " for pose " 
-							// 		<< m_goalmap[neighbor] << ": " << neighborSurvival << ", " 
-							// 			<< neighbor_reachability << ", " 
-							// 				<< neighborSurvival * neighbor_reachability << "\n";
-							// std::cout << "add neighbor: " << neighbor << "  " << neighbor_g + neighbor_h << "\n";
-							// std::cout << "[ ";
-							// for (auto const &l: neighborLabels)
-							// {
-							// 	std::cout << l << " ";
-							// }
-							// std::cout << "]  ,";
-							// std::cout << "[ ";
-							// for (auto const &gi : std::vector<int>(1, m_goalmap[neighbor]))
-							// {
-							// 	std::cout << gi << " ";
-							// }
-							// std::cout << "]\n";
-							// std::cout << neighborSurvival << ", " << neighbor_reachability << ", " 
-							// 				<< neighbor_successValue << ", " << "true" 
-							// 											<< ", " << current->m_id << "\n\n";
-						}
-					}
-			
-
-				}
-
-			}
-			
 		}
-		// std::cout << "press any key to continue...\n";
-		// std::cin.get(); 
 
 	}
-	// You are reaching here since the open list is empty and the goal is not found
-	std::cout << "The problem is not solvable. Search failed...\n";
-	m_isFailure = true;
 }
 
-void MaxSuccessGreedySolver_t::checkPathSuccess(int nhypo)
-{
-	m_obstaclesCollided = 0;
-	m_isPathSuccess = true;
-	// compute the obstacles collided
-	// loop through the m_goalLabels
-	for (auto const &l : m_goalLabels)
-	{
-		if (l % nhypo == 0)
-		{
-			m_obstaclesCollided += 1;
-		}
-	}
-	if (m_obstaclesCollided != 0 or m_goalIdxReached != 0)
-	{
-		m_isPathSuccess = false;
-	}
-
-}
-
-std::vector<int> MaxSuccessGreedySolver_t::update_goalIdxes(std::vector<int> currGoalIndexes, 
-																		std::vector<int> edgelabels)
+std::vector<int> MaxSuccessGreedySolver_t::update_goalIdxes(const std::vector<int> &currGoalIndexes, 
+																		ConstRange_t<int> edgelabels)
 {
 	std::vector<int> newGoalIndexes;
 	// loop through all current goal indexes
@@ -382,92 +266,57 @@ std::vector<int> MaxSuccessGreedySolver_t::update_goalIdxes(std::vector<int> cur
 	return newGoalIndexes;	
 }
 
-int MaxSuccessGreedySolver_t::countObs()
-{
-	int maxIdx = -1;
-	int tempIdx;
-	for (int ii=0; ii < m_labelWeights.size(); ii++)
-	{
-		tempIdx = m_labelWeights[ii].first;
-		if (maxIdx < tempIdx)
-		{
-			maxIdx = tempIdx;
-		}
-	}
-	return (maxIdx + 1);
-}
-
-void MaxSuccessGreedySolver_t::computeGoalMean(Graph_t &g)
+void MaxSuccessGreedySolver_t::computeGoalMean(const Graph_t &g, HeuristicMode_t heuristic)
 {
 	// first figure out m_goalhypos (how many unique goal hypos)
-	std::vector<int>::iterator ip;
 	m_goalhypos = m_targetPoses;
 	sort(m_goalhypos.begin(), m_goalhypos.end());
 	m_goalhypos.resize(std::distance(m_goalhypos.begin(), 
 											std::unique(m_goalhypos.begin(), m_goalhypos.end())));
-	// initialization for m_goalCounts and m_goalMean
-	for (int ii=0; ii < m_goalhypos.size(); ii++)
-	{
-		m_goalCounts[m_goalhypos[ii]] = 0;
-		m_goalMean[m_goalhypos[ii]] = std::vector<float>(g.getState(0).size(), 0.0);
-	}
-
-	// loop through all goals and their correpsonding state values into the right category
+	// the goals of every goal hypothesis (the vectors of the hypotheses of a previous
+	// query are kept for their buffers)
+	for (auto &hg : m_hypoGoals) { hg.second.clear(); }
 	for (int ii=0; ii < m_goalSet.size(); ii++)
 	{
-		std::vector<float> temp_state = g.getState(m_goalSet[ii]);
-		m_goalCounts[m_targetPoses[ii]] += 1;
-		for (int jj=0; jj < temp_state.size(); jj++)
-		{
-			m_goalMean[m_targetPoses[ii]][jj] += temp_state[jj];
-		}
+		m_hypoGoals[m_targetPoses[ii]].push_back(m_goalSet[ii]);
 	}
 
-	for (int ii=0; ii < m_goalhypos.size(); ii++)
+	// the heuristic to the goals of every goal hypothesis. The eager goal mean and the
+	// cost-to-go tables are shared through the graph, so a goal subset seen before
+	// costs no pass over the nodes
+	m_heuristic = heuristic;
+	for (auto const &gi : m_goalhypos)
 	{
-		for (int jj=0; jj < m_goalMean[ii].size(); jj++)
-		{
-			m_goalMean[ii][jj] /= m_goalCounts[ii];
-		}
+		m_hypoGoalTables[gi].build(g.getnNodes(), m_hypoGoals[gi], 
+										std::vector<int>(m_hypoGoals[gi].size(), gi));
+		m_hypoH[gi].build(g, m_hypoGoals[gi], m_hypoGoalTables[gi], m_heuristic);
 	}
-
 }
 
-float MaxSuccessGreedySolver_t::computeH(std::vector<float> temp_state, std::vector<int> goalIdxes)
+float MaxSuccessGreedySolver_t::computeH(const Graph_t &g, int node, const std::vector<int> &goalIdxes)
 {
-	// Initialize temp_hs
-	std::map<int, float> temp_hs;
-	for (auto const &gi : goalIdxes)
-	{
-		temp_hs[gi] = 0.0;
-	}
-	// fill in temp_hs
+	// compute the weighted heurisitic (goalIdxes are sorted and unique)
+	float temp_h = 0.0;
 	for (auto const &gi : goalIdxes)
 	{
-		for (int qq=0; qq < temp_state.size(); qq++)
+		// no term for a hypothesis whose goals cannot be reached from the node (cost-to-go)
+		float h = m_hypoH[gi][node];
+		if (h != std::numeric_limits<float>::infinity())
 		{
-			temp_hs[gi] += pow(temp_state[qq] - m_goalMean[gi][qq], 2);
+			temp_h += h * g.getSingleWeight(gi);
 		}
-
-	}
-	// compute the weighted heurisitic
-	float temp_h = 0.0;
-	for (auto const &th : temp_hs)
-	{
-		temp_h += sqrt(th.second) * m_labelWeights[th.first].second;
 	}
 
 	return temp_h;
 }
 
-float MaxSuccessGreedySolver_t::computeSurvival(std::vector<int> labels)
+float MaxSuccessGreedySolver_t::computeSurvival(const Graph_t &g, int labels)
 {
 	float survival = 1.0;
-	std::vector<float> CollisionPerObs(m_nobstacles, 0.0);
-	for (auto const &label : labels)
-	{
-		CollisionPerObs[m_labelWeights[label].first] += m_labelWeights[label].second;
-	}
+	std::vector<float> CollisionPerObs(g.getnObstacles(), 0.0);
+	m_labelSets.get(labels).forEach([&](int label) {
+		CollisionPerObs[g.getLabelObstacle(label)] += g.getSingleWeight(label);
+	});
 	// compute survival based on CollisionPerObs
 	for (auto const &collision_prob : CollisionPerObs)
 	{
@@ -477,13 +326,13 @@ float MaxSuccessGreedySolver_t::computeSurvival(std::vector<int> labels)
 	return survival;
 }
 
-float MaxSuccessGreedySolver_t::computeReach(std::vector<int> goalIdxes)
+float MaxSuccessGreedySolver_t::computeReach(const Graph_t &g, const std::vector<int> &goalIdxes)
 {
 	float MaxReach = 0.0;
 	float temp_reach;
 	for (auto const &gi : goalIdxes)
 	{
-		temp_reach = m_labelWeights[gi].second;
+		temp_reach = g.getSingleWeight(gi);
 		if (MaxReach < temp_reach)
 		{
 			MaxReach = temp_reach;
@@ -493,132 +342,4 @@ float MaxSuccessGreedySolver_t::computeReach(std::vector<int> goalIdxes)
 	return MaxReach;
 }
 
-void MaxSuccessGreedySolver_t::print_path()
-{
-	// print the path for checking purpose
-	std::cout << "path: \n";
-	for (auto const &waypoint : m_path)
-	{
-		std::cout << waypoint << " ";
-	}
-	std::cout << "\n";
-}
-
-void MaxSuccessGreedySolver_t::printLabels()
-{
-	std::cout << "labels: " << "< ";
-	for (auto const &l : m_goalLabels)
-	{
-		std::cout << l << " ";
-	}
-	std::cout << ">\n";	
-}
-
-void MaxSuccessGreedySolver_t::print_cost()
-{
-	std::cout << "cost: " << m_pathCost << "\n";
-}
 		
-void MaxSuccessGreedySolver_t::print_goalIdxReached()
-{
-	std::cout << "The reaching target pose is: " << m_goalIdxReached << "\n";
-}
-
-void MaxSuccessGreedySolver_t::printAll()
-{
-	print_path();
-	print_cost();
-	printLabels();
-	print_goalIdxReached();
-}
-
-std::vector<int> MaxSuccessGreedySolver_t::label_union(std::vector<int> s1, std::vector<int> s2)
-{
-	// sort the sets first before applying union operation
-	std::sort(s1.begin(), s1.end());
-	std::sort(s2.begin(), s2.end());
-
-	// Declaring resultant vector for union
-	std::vector<int> v(s1.size()+s2.size());
-	// using function set_union() to compute union of 2
-	// containers v1 and v2 and store result in v
-	auto it = std::set_union(s1.begin(), s1.end(), s2.begin(), s2.end(), v.begin());
-
-	// resizing new container
-	v.resize(it - v.begin());
-	return v;	
-}
-
-int MaxSuccessGreedySolver_t::getIndex(int goalIdx)
-{
-	int temp_idx = -1;
-	for (int ii=0; ii < m_goalSet.size(); ii++)
-	{
-		if (goalIdx == m_goalSet[ii])
-		{
-			temp_idx = ii;
-			break;
-		}
-	}
-	return temp_idx;
-}
-
-
-void MaxSuccessGreedySolver_t::back_track_path()
-{
-	// start from the goal
-	MaxSuccGreedyNode_t *current = m_closed[m_closed.size()-1];
-	while (current->m_id != m_start)
-	{
-		// keep backtracking the path until you reach the start
-		m_path.push_back(current->m_id);
-		current = current->m_parent;
-	}
-	// finally put the start into the path
-	m_path.push_back(current->m_id);
-
-	// print the path for checking purpose
-	// std::cout << "path: \n";
-	// for (auto const &waypoint : m_path)
-	// {
-	// 	std::cout << waypoint << " ";
-	// }
-	// std::cout << "\n";
-}
-
-void MaxSuccessGreedySolver_t::pathToTrajectory(Graph_t &g)
-{
-	// start from the start
-	for (int i=m_path.size()-1; i >=0; i--)
-	{
-		m_trajectory.push_back(g.getState(m_path[i]));
-
-	}
-	// // print the trajectory for checking purpose
-	// std::cout << "The trajectory: \n";
-	// for (auto const &t : m_trajectory)
-	// {
-	// 	for (auto const &d : t)
-	// 	{
-	// 		std::cout << d << "   ";
-	// 	}
-	// 	std::cout << "\n";
-	// }
-}
-
-void MaxSuccessGreedySolver_t::writeTrajectory(std::string trajectory_file)
-{
-	m_outFile_.open(trajectory_file);
-	if (m_outFile_.is_open())
-	{
-		for (auto const &t : m_trajectory)
-		{
-			for (auto const &d : t)
-			{
-				m_outFile_ << d << " ";
-			}
-			m_outFile_ << "\n";
-		}
-	}
-	m_outFile_.close();
-}
\ No newline at end of file
@@ -11,6 +11,9 @@ with specified start and goal set */
 #include <map>
 
 #include "Graph.hpp"
+#include "SearchCore.hpp"
+#include "Heuristic.hpp"
+#include "StampedArray.hpp"
 
 struct MaxSuccGreedyNode_t
 {
@@ -18,10 +21,9 @@ struct MaxSuccGreedyNode_t
 	float m_g;
 	float m_h;
 	float m_f;
-	// label and survivability
-	std::vector<int> m_labels;
+	// label set and survivability
+	int m_labels; // id of the label set in the search's LabelSetTable_t
 	float m_survival;
-	int m_labelCardinality;
 
 	//goal uncertainty
 	std::vector<int> m_goalIndexes;
@@ -29,10 +31,14 @@ struct MaxSuccGreedyNode_t
 	float m_successValue;
 	bool m_isGoal;
 
-	MaxSuccGreedyNode_t *m_parent;
+	int m_parent; // index of the parent in the node pool, -1 for the start
 
-	MaxSuccGreedyNode_t(int id, float g, float h, std::vector<int> labels, float survival, 
-		std::vector<int> goalIdxes, float reachability, bool isGoal, MaxSuccGreedyNode_t *parent)
+	// the priority key, kept in the open list
+	struct Key_t { float m_successValue; float m_f; float m_h; };
+	Key_t key() const { return Key_t{m_successValue, m_f, m_h}; }
+
+	MaxSuccGreedyNode_t(int id, float g, float h, int labels, float survival, 
+		std::vector<int> goalIdxes, float reachability, bool isGoal, int parent)
 	{
 		m_id = id;
 		m_g = g;
@@ -40,7 +46,6 @@ struct MaxSuccGreedyNode_t
 		m_f = m_g + m_h;
 		m_labels = labels;
 		m_survival = survival;
-		m_labelCardinality = m_labels.size();
 		m_goalIndexes = goalIdxes;
 		m_reachability = reachability;
 		m_successValue = m_survival * m_reachability;
@@ -51,7 +56,9 @@ struct MaxSuccGreedyNode_t
 
 struct MaxSuccGreedyNode_comparison
 {
-	bool operator()(const MaxSuccGreedyNode_t* a, const MaxSuccGreedyNode_t* b)
+	// compares nodes or their keys
+	template <typename T>
+	bool operator()(const T* a, const T* b)
 	{
 		if (a->m_successValue == b->m_successValue)
 		{
@@ -67,78 +74,66 @@ struct MaxSuccGreedyNode_comparison
 	}
 };
 
-class MaxSuccessGreedySolver_t
+class MaxSuccessGreedySolver_t : public SearchCore_t<MaxSuccessGreedySolver_t, MaxSuccGreedyNode_t, MaxSuccGreedyNode_comparison,
+							IndexedOpenList_t<MaxSuccGreedyNode_t, MaxSuccGreedyNode_comparison>>
 {
-	std::vector<int> m_path;
-	std::vector<std::vector<float>> m_trajectory;
-
-	std::priority_queue<MaxSuccGreedyNode_t*, std::vector<MaxSuccGreedyNode_t*>, 
-													MaxSuccGreedyNode_comparison> m_open;
-	std::vector<MaxSuccGreedyNode_t*> m_closed;
-	std::vector<bool> m_expanded;
-	std::map<int, bool> m_expandedForGoals;
-	std::vector<float> m_F;
-	std::map<int, float> m_FForGoals;
-	std::vector<float> m_highestSuccess;
-	std::map<int, float> m_highestSuccessForGoals;
-
-	// No m_H since heuristics are dynamic
+	friend class SearchCore_t<MaxSuccessGreedySolver_t, MaxSuccGreedyNode_t, MaxSuccGreedyNode_comparison, IndexedOpenList_t<MaxSuccGreedyNode_t, MaxSuccGreedyNode_comparison>>;
 
-	int m_start;
+	StampedSet_t m_expanded;
+	// the ...ForGoals vectors are indexed by the position of the goal in m_goalSet
+	std::vector<bool> m_expandedForGoals;
+	StampedArray_t<float> m_F;
+	std::vector<float> m_FForGoals;
+	StampedArray_t<float> m_highestSuccess;
+	std::vector<float> m_highestSuccessForGoals;
 
-	std::vector<int> m_goalSet;
-	std::vector<int> m_targetPoses;
-	std::map<int, int> m_goalmap;
+	// No m_H since heuristics are dynamic
 
 	std::vector<int> m_goalhypos;
-	std::map<int, int> m_goalCounts;
-	std::map<int, std::vector<float>> m_goalMean;
-
-	std::map<int, std::pair<int, float>> m_labelWeights;
-	int m_nobstacles;
-
-	std::ofstream m_outFile_;
-	bool m_isFailure;
-
-	std::vector<int> m_goalLabels;
-	int m_goalIdxReached;
-	int m_obstaclesCollided;
-	bool m_isPathSuccess;
-	float m_pathCost;
+	// the goals of every goal hypothesis, their goal table and the heuristic to them
+	// (see Heuristic.hpp), kept from one reset to the next for their buffers
+	HeuristicMode_t m_heuristic;
+	std::map<int, std::vector<int>> m_hypoGoals;
+	std::map<int, GoalTable_t> m_hypoGoalTables;
+	std::map<int, GoalHeuristic_t> m_hypoH;
+
+	// the label weights are read from the graph, which may update them between queries:
+	// the version they had when the start node was made (see Graph_t::setLabelWeight)
+	std::uint64_t m_labelWeightsVersion;
+
+	// search policies (see SearchCore.hpp)
+	// a goal copy of a node is expanded at most once per goal, a normal node once
+	bool isDominated(const MaxSuccGreedyNode_t *n)
+	{
+		if (n->m_isGoal) { return m_expandedForGoals[m_goalTable->getGoalSlot(n->m_id)]; }
+		return m_expanded[n->m_id];
+	}
+	void close(const MaxSuccGreedyNode_t *n)
+	{
+		if (n->m_isGoal) { m_expandedForGoals[m_goalTable->getGoalSlot(n->m_id)] = true; }
+		else { m_expanded.insert(n->m_id); }
+	}
+	bool isGoal(const MaxSuccGreedyNode_t *n) { return n->m_isGoal; }
+	void relax(const Graph_t &g, const MaxSuccGreedyNode_t *current, int currentIdx, int neighbor, int e);
 
 public:
-	MaxSuccessGreedySolver_t(Graph_t &g);
-	~MaxSuccessGreedySolver_t();
-
-	std::vector<int> update_goalIdxes(std::vector<int> currGoalIndexes, std::vector<int> edgelabels);
-
-	int countObs();
-	void computeGoalMean(Graph_t &g);
-	float computeH(std::vector<float> temp_state, std::vector<int> goalIdxes);
-	float computeSurvival(std::vector<int> labels);
-	float computeReach(std::vector<int> goalIdxes); // the highest reachability among available goals
-	void MSGreedy_search(Graph_t &g);
-	void back_track_path();
-	void pathToTrajectory(Graph_t &g);
-	void writeTrajectory(std::string trajectory_file);
-	void printLabels();
-	void print_path();
-	void print_cost();
-	void print_goalIdxReached();
-	void printAll();
-
-	std::vector<int> label_union(std::vector<int> s1, std::vector<int> s2);
-	int getIndex(int goalIdx);
-
-	// harvest the results
-	void checkPathSuccess(int nhypo);
-
-	// getters
-	std::vector<std::vector<float>> getTrajectory() {return m_trajectory;}
-	bool getFailureIndicator() {return m_isFailure;}
-	int getObstaclesCollided() {return m_obstaclesCollided;}
-	bool getIsPathSuccess() {return m_isPathSuccess;}
-	float getPathCost() {return m_pathCost;}
+	// heuristic: which h to use to the goals of every goal hypothesis (see Heuristic.hpp)
+	MaxSuccessGreedySolver_t(const Graph_t &g, HeuristicMode_t heuristic = HEURISTIC_GOALMEAN);
+	// start over with another query on the same graph and heuristic mode, reusing the
+	// buffers. The goals must be goals of the graph (for their target poses). It costs
+	// the previous search, not the size of the graph, except for the first eager goal
+	// mean or cost-to-go table of a goal subset (shared through the graph)
+	void reset(const Graph_t &g, int start, std::vector<int> goalSet);
+
+	std::vector<int> update_goalIdxes(const std::vector<int> &currGoalIndexes, 
+															ConstRange_t<int> edgelabels);
+
+	void computeGoalMean(const Graph_t &g, HeuristicMode_t heuristic = HEURISTIC_GOALMEAN);
+	float computeH(const Graph_t &g, int node, const std::vector<int> &goalIdxes);
+	float computeSurvival(const Graph_t &g, int labels); // labels: id of a label set
+	float computeReach(const Graph_t &g, const std::vector<int> &goalIdxes); // the highest reachability among available goals
+	// a search after the graph updated its label weights starts over on the same query
+	void MSGreedy_search(const Graph_t &g);
 };
 
 
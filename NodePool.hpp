@@ -0,0 +1,83 @@
+/* This hpp file declares a pool for the nodes of one search.
+
+Nodes are constructed in place in fixed-size chunks and never move, so a node
+can be referred to either by its address or by its 32-bit index in the pool.
+Nodes are not freed one by one: they all go away together with clear() or
+when the pool is destroyed. The chunks are kept on clear() so that a pool can
+be reused by another search without allocating again. */
+
+#ifndef NODEPOOL_H
+#define NODEPOOL_H
+
+#include <vector>
+#include <new>
+#include <utility>
+#include <type_traits>
+#include <cstddef>
+
+template <typename Node>
+class NodePool_t
+{
+	// 4096 nodes per chunk
+	static const int CHUNK_BITS = 12;
+	static const int CHUNK_SIZE = 1 << CHUNK_BITS;
+	static const int CHUNK_MASK = CHUNK_SIZE - 1;
+
+	std::vector<Node*> m_chunks;
+	int m_size;
+
+public:
+	NodePool_t() : m_size(0) {}
+	~NodePool_t();
+	NodePool_t(const NodePool_t&) = delete;
+	NodePool_t& operator=(const NodePool_t&) = delete;
+
+	// construct a node at the end of the pool and return its index
+	template <typename... Args>
+	int create(Args&&... args);
+	// destroy all the nodes, keep the memory
+	void clear();
+
+	Node& operator[](int i) { return m_chunks[i >> CHUNK_BITS][i & CHUNK_MASK]; }
+	const Node& operator[](int i) const { return m_chunks[i >> CHUNK_BITS][i & CHUNK_MASK]; }
+	int size() const { return m_size; }
+};
+
+
+template <typename Node>
+NodePool_t<Node>::~NodePool_t()
+{
+	clear();
+	for (auto &c : m_chunks)
+	{
+		::operator delete(c);
+	}
+}
+
+template <typename Node>
+template <typename... Args>
+int NodePool_t<Node>::create(Args&&... args)
+{
+	if ((m_size >> CHUNK_BITS) == (int)m_chunks.size())
+	{
+		m_chunks.push_back(static_cast<Node*>(::operator new(sizeof(Node)*CHUNK_SIZE)));
+	}
+	new (&m_chunks[m_size >> CHUNK_BITS][m_size & CHUNK_MASK]) Node(std::forward<Args>(args)...);
+	return m_size++;
+}
+
+template <typename Node>
+void NodePool_t<Node>::clear()
+{
+	// nothing to do per node unless it owns memory (e.g. a label vector)
+	if (!std::is_trivially_destructible<Node>::value)
+	{
+		for (int i=0; i < m_size; i++)
+		{
+			(*this)[i].~Node();
+		}
+	}
+	m_size = 0;
+}
+
+#endif
@@ -0,0 +1,142 @@
+/* This hpp file declares a read-only view over the node states of a
+graph stored as structure of arrays (SoA): all the values of dimension j
+are contiguous, dimension j of node i is data[j*stride + i], and every
+dimension starts on a cache line.
+
+The number of dimensions (DOF) is a template parameter so that the common
+robots (e.g. the 7-DOF Motoman) get kernels with the dimension loop fully
+unrolled; DOF = 0 is the fallback with the number of dimensions known at
+run time only.
+
+On x86 the distance kernel also has an AVX2 version (8 nodes per
+instruction), picked at run time when the CPU has it, so the program does not
+need to be built with -mavx2. It adds up the dimensions in the same order as
+the scalar kernel and gives the same results. */
+
+#ifndef NODESTATES_H
+#define NODESTATES_H
+
+#include <cstddef>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define NODE_STATES_AVX2
+#endif
+
+#include "ConstRange.hpp"
+
+// values per cache line, the stride of every dimension is a multiple of it
+const std::size_t NODE_STATES_ALIGNMENT = 64;
+const std::size_t NODE_STATES_PER_LINE = NODE_STATES_ALIGNMENT / sizeof(float);
+
+// number of floats between two dimensions of the SoA buffer for nNodes nodes
+inline std::size_t nodeStates_stride(int nNodes)
+{
+	return (std::size_t(nNodes) + NODE_STATES_PER_LINE-1) / NODE_STATES_PER_LINE * NODE_STATES_PER_LINE;
+}
+
+// true if the CPU running the program has AVX2 (checked once)
+inline bool nodeStates_hasAvx2()
+{
+#ifdef NODE_STATES_AVX2
+	static const bool hasAvx2 = __builtin_cpu_supports("avx2");
+	return hasAvx2;
+#else
+	return false;
+#endif
+}
+
+template <int DOF>
+class NodeStates_t
+{
+	const float *m_data;
+	std::size_t m_stride;
+	int m_nDims;
+
+public:
+	// Constructor
+	NodeStates_t(const float *data, std::size_t stride, int ndims) 
+		: m_data(data), m_stride(stride), m_nDims(ndims) {}
+
+	int getnDims() const { return (DOF > 0) ? DOF : m_nDims; }
+	std::size_t getStride() const { return m_stride; }
+	// all the values of dimension j
+	const float* getDim(int j) const { return m_data + j*m_stride; }
+	float get(int i, int j) const { return m_data[j*m_stride + i]; }
+	StridedRange_t<float> getState(int i) const
+	{
+		return StridedRange_t<float>(m_data + i, getnDims(), m_stride);
+	}
+
+	// out[i] = squared euclidean distance between node i and point, for i in [begin, end)
+	void squaredDistances(const float *point, int begin, int end, float *out) const
+	{
+#ifdef NODE_STATES_AVX2
+		if (nodeStates_hasAvx2())
+		{
+			squaredDistances_avx2(point, begin, end, out);
+			return;
+		}
+#endif
+		squaredDistances_scalar(point, begin, end, out);
+	}
+
+	void squaredDistances_scalar(const float *point, int begin, int end, float *out) const
+	{
+		const float *__restrict x = m_data;
+		float *__restrict d2 = out;
+		if (DOF > 0)
+		{
+			// one pass over the nodes, the dimension loop is unrolled
+			for (int i=begin; i < end; i++)
+			{
+				float temp_h = 0.0;
+				for (int j=0; j < DOF; j++)
+				{
+					float d = x[j*m_stride + i] - point[j];
+					temp_h += d*d;
+				}
+				d2[i] = temp_h;
+			}
+		}
+		else
+		{
+			// one pass per dimension, each over contiguous values
+			for (int i=begin; i < end; i++) { d2[i] = 0.0; }
+			for (int j=0; j < m_nDims; j++)
+			{
+				const float *xj = x + j*m_stride;
+				const float pj = point[j];
+				for (int i=begin; i < end; i++)
+				{
+					float d = xj[i] - pj;
+					d2[i] += d*d;
+				}
+			}
+		}
+	}
+
+#ifdef NODE_STATES_AVX2
+	// only call it if nodeStates_hasAvx2()
+	__attribute__((target("avx2")))
+	void squaredDistances_avx2(const float *point, int begin, int end, float *out) const
+	{
+		const int nDims = getnDims();
+		int i = begin;
+		for (; i+8 <= end; i += 8)
+		{
+			__m256 temp_h = _mm256_setzero_ps();
+			for (int j=0; j < nDims; j++)
+			{
+				__m256 d = _mm256_sub_ps(_mm256_loadu_ps(m_data + j*m_stride + i), _mm256_set1_ps(point[j]));
+				temp_h = _mm256_add_ps(temp_h, _mm256_mul_ps(d, d));
+			}
+			_mm256_storeu_ps(out + i, temp_h);
+		}
+		// the last (up to 7) nodes
+		squaredDistances_scalar(point, i, end, out);
+	}
+#endif
+};
+
+#endif
@@ -0,0 +1,357 @@
+/* This hpp file declares the open lists a SearchCore_t can run on.
+
+They all hold pool indexes of nodes (see NodePool.hpp) and are ordered by the
+solver's comparator, which must accept pointers to nodes (and, except for the
+lazy list, pointers to Node::Key_t). Every push names an item: the node id, or an id
+past the nodes for a node that stands for something else (e.g. the goal copy
+of a node).
+
+LazyOpenList_t is a binary heap that keeps every push. An improved node is
+pushed again and the old entry is skipped when popped. Use it when one item
+may legitimately be open several times (the exact solvers).
+
+IndexedOpenList_t is a 4-ary heap with at most one entry per item. Pushing an
+item which is already open replaces its node and key (decrease-key). The key
+is stored in the heap entry so that sifting does not touch the nodes.
+
+BucketOpenList_t is for comparators whose first key is a small integer, the
+node's bucket() (the label cardinality of the MCR solvers). It keeps one
+4-ary heap per bucket, ordered by the rest of the key, and pops from the
+lowest non-empty bucket. With DecreaseKey it holds one entry per item like
+IndexedOpenList_t, otherwise it keeps every push like LazyOpenList_t.
+
+init() empties a list for another search. The item tables are only grown,
+never filled again: emptying costs the entries left by the previous search. */
+
+#ifndef OPENLIST_H
+#define OPENLIST_H
+
+#include <vector>
+#include <algorithm>
+
+#include "NodePool.hpp"
+
+template <typename Node, typename Compare>
+class LazyOpenList_t
+{
+	// orders pool indexes by the solver's priority key on the nodes
+	struct IndexCompare_t
+	{
+		const NodePool_t<Node> *m_nodes;
+		Compare m_compare;
+		IndexCompare_t(const NodePool_t<Node> *nodes) : m_nodes(nodes) {}
+		bool operator()(int a, int b) { return m_compare(&(*m_nodes)[a], &(*m_nodes)[b]); }
+	};
+
+	// a binary heap (as std::priority_queue keeps it), which can be emptied in place
+	std::vector<int> m_heap;
+	IndexCompare_t m_compare;
+
+public:
+	LazyOpenList_t(const NodePool_t<Node> *nodes) : m_compare(nodes) {}
+
+	void init(int nItems) { m_heap.clear(); }
+	void push(int item, int nodeIdx)
+	{
+		m_heap.push_back(nodeIdx);
+		std::push_heap(m_heap.begin(), m_heap.end(), m_compare);
+	}
+	// remove the best entry and return its node
+	int pop()
+	{
+		std::pop_heap(m_heap.begin(), m_heap.end(), m_compare);
+		int nodeIdx = m_heap.back();
+		m_heap.pop_back();
+		return nodeIdx;
+	}
+	bool empty() const { return m_heap.empty(); }
+	int size() const { return m_heap.size(); }
+};
+
+
+template <typename Node, typename Compare>
+class IndexedOpenList_t
+{
+	typedef typename Node::Key_t Key_t;
+
+	struct Entry_t
+	{
+		Key_t m_key;
+		int m_item;
+		int m_node;
+	};
+
+	const NodePool_t<Node> *m_nodes;
+	Compare m_compare;
+	std::vector<Entry_t> m_heap;
+	std::vector<int> m_position; // item -> slot in m_heap, -1 if not open
+
+	// true if the entry in slot a goes below the entry in slot b
+	bool below(int a, int b) { return m_compare(&m_heap[a].m_key, &m_heap[b].m_key); }
+	void place(int slot, const Entry_t &e) { m_heap[slot] = e; m_position[e.m_item] = slot; }
+	void sift_up(int slot);
+	void sift_down(int slot);
+
+public:
+	IndexedOpenList_t(const NodePool_t<Node> *nodes) : m_nodes(nodes) {}
+
+	// items are 0 .. nItems-1
+	void init(int nItems);
+	void push(int item, int nodeIdx);
+	// remove the best entry and return its node
+	int pop();
+	// the node of the best entry, without removing it (the list must not be empty)
+	int top() const { return m_heap[0].m_node; }
+	bool empty() const { return m_heap.empty(); }
+	int size() const { return m_heap.size(); }
+	bool contains(int item) const { return m_position[item] != -1; }
+};
+
+
+template <typename Node, typename Compare>
+void IndexedOpenList_t<Node, Compare>::init(int nItems)
+{
+	// only the items still open are not at -1
+	for (auto const &e : m_heap) { m_position[e.m_item] = -1; }
+	m_heap.clear();
+	if ((int)m_position.size() < nItems) { m_position.resize(nItems, -1); }
+}
+
+template <typename Node, typename Compare>
+void IndexedOpenList_t<Node, Compare>::push(int item, int nodeIdx)
+{
+	Entry_t e = {(*m_nodes)[nodeIdx].key(), item, nodeIdx};
+	int slot = m_position[item];
+	if (slot == -1)
+	{
+		m_heap.push_back(e);
+		place(m_heap.size()-1, e);
+		sift_up(m_heap.size()-1);
+		return;
+	}
+	// already open: the new node replaces the old one
+	place(slot, e);
+	sift_up(slot);
+	sift_down(m_position[item]);
+}
+
+template <typename Node, typename Compare>
+int IndexedOpenList_t<Node, Compare>::pop()
+{
+	Entry_t top = m_heap[0];
+	m_position[top.m_item] = -1;
+	Entry_t last = m_heap.back();
+	m_heap.pop_back();
+	if (!m_heap.empty())
+	{
+		place(0, last);
+		sift_down(0);
+	}
+	return top.m_node;
+}
+
+template <typename Node, typename Compare>
+void IndexedOpenList_t<Node, Compare>::sift_up(int slot)
+{
+	Entry_t e = m_heap[slot];
+	while (slot > 0)
+	{
+		int parent = (slot-1) >> 2;
+		if (!m_compare(&m_heap[parent].m_key, &e.m_key)) { break; }
+		place(slot, m_heap[parent]);
+		slot = parent;
+	}
+	place(slot, e);
+}
+
+template <typename Node, typename Compare>
+void IndexedOpenList_t<Node, Compare>::sift_down(int slot)
+{
+	Entry_t e = m_heap[slot];
+	int n = m_heap.size();
+	while (true)
+	{
+		int first = 4*slot + 1;
+		if (first >= n) { break; }
+		// the best of the (up to) four children
+		int best = first;
+		int last = (first+4 < n) ? first+4 : n;
+		for (int c = first+1; c < last; c++)
+		{
+			if (below(best, c)) { best = c; }
+		}
+		if (!m_compare(&e.m_key, &m_heap[best].m_key)) { break; }
+		place(slot, m_heap[best]);
+		slot = best;
+	}
+	place(slot, e);
+}
+
+
+template <typename Node, typename Compare, bool DecreaseKey>
+class BucketOpenList_t
+{
+	typedef typename Node::Key_t Key_t;
+
+	struct Entry_t
+	{
+		Key_t m_key;
+		int m_item;
+		int m_node;
+	};
+
+	const NodePool_t<Node> *m_nodes;
+	Compare m_compare;
+	std::vector<std::vector<Entry_t>> m_buckets; // each one is a 4-ary heap
+	int m_lowest; // no entry in a bucket below it
+	int m_size;
+	// with DecreaseKey only: item -> bucket and slot in it, -1 if not open
+	std::vector<int> m_bucketOf;
+	std::vector<int> m_position;
+
+	void place(std::vector<Entry_t> &heap, int slot, const Entry_t &e);
+	void sift_up(std::vector<Entry_t> &heap, int slot);
+	void sift_down(std::vector<Entry_t> &heap, int slot);
+	void erase(int bucket, int slot);
+
+public:
+	BucketOpenList_t(const NodePool_t<Node> *nodes) : m_nodes(nodes), m_lowest(0), m_size(0) {}
+
+	// items are 0 .. nItems-1
+	void init(int nItems);
+	void push(int item, int nodeIdx);
+	// remove the best entry and return its node
+	int pop();
+	bool empty() const { return m_size == 0; }
+	int size() const { return m_size; }
+};
+
+
+template <typename Node, typename Compare, bool DecreaseKey>
+void BucketOpenList_t<Node, Compare, DecreaseKey>::init(int nItems)
+{
+	// keep the buckets (and their memory) around
+	for (auto &b : m_buckets)
+	{
+		if (DecreaseKey)
+		{
+			// only the items still open are not at -1
+			for (auto const &e : b) { m_bucketOf[e.m_item] = -1; m_position[e.m_item] = -1; }
+		}
+		b.clear();
+	}
+	m_lowest = 0;
+	m_size = 0;
+	if (DecreaseKey and (int)m_bucketOf.size() < nItems)
+	{
+		m_bucketOf.resize(nItems, -1);
+		m_position.resize(nItems, -1);
+	}
+}
+
+template <typename Node, typename Compare, bool DecreaseKey>
+void BucketOpenList_t<Node, Compare, DecreaseKey>::push(int item, int nodeIdx)
+{
+	const Node &n = (*m_nodes)[nodeIdx];
+	Entry_t e = {n.key(), item, nodeIdx};
+	int bucket = n.bucket();
+	if (bucket >= (int)m_buckets.size()) { m_buckets.resize(bucket+1); }
+	if (DecreaseKey and m_bucketOf[item] != -1)
+	{
+		// already open: the new node replaces the old one
+		int oldBucket = m_bucketOf[item];
+		if (oldBucket == bucket)
+		{
+			std::vector<Entry_t> &heap = m_buckets[bucket];
+			place(heap, m_position[item], e);
+			sift_up(heap, m_position[item]);
+			sift_down(heap, m_position[item]);
+			return;
+		}
+		erase(oldBucket, m_position[item]);
+	}
+	std::vector<Entry_t> &heap = m_buckets[bucket];
+	heap.push_back(e);
+	if (DecreaseKey) { m_bucketOf[item] = bucket; }
+	place(heap, heap.size()-1, e);
+	sift_up(heap, heap.size()-1);
+	if (bucket < m_lowest) { m_lowest = bucket; }
+	m_size++;
+}
+
+template <typename Node, typename Compare, bool DecreaseKey>
+int BucketOpenList_t<Node, Compare, DecreaseKey>::pop()
+{
+	while (m_buckets[m_lowest].empty()) { m_lowest++; }
+	std::vector<Entry_t> &heap = m_buckets[m_lowest];
+	Entry_t top = heap[0];
+	erase(m_lowest, 0);
+	return top.m_node;
+}
+
+template <typename Node, typename Compare, bool DecreaseKey>
+void BucketOpenList_t<Node, Compare, DecreaseKey>::erase(int bucket, int slot)
+{
+	std::vector<Entry_t> &heap = m_buckets[bucket];
+	if (DecreaseKey)
+	{
+		m_bucketOf[heap[slot].m_item] = -1;
+		m_position[heap[slot].m_item] = -1;
+	}
+	Entry_t last = heap.back();
+	heap.pop_back();
+	m_size--;
+	if (slot < (int)heap.size())
+	{
+		place(heap, slot, last);
+		sift_up(heap, slot);
+		sift_down(heap, DecreaseKey ? m_position[last.m_item] : slot);
+	}
+}
+
+template <typename Node, typename Compare, bool DecreaseKey>
+void BucketOpenList_t<Node, Compare, DecreaseKey>::place(std::vector<Entry_t> &heap, int slot, 
+																		const Entry_t &e)
+{
+	heap[slot] = e;
+	if (DecreaseKey) { m_position[e.m_item] = slot; }
+}
+
+template <typename Node, typename Compare, bool DecreaseKey>
+void BucketOpenList_t<Node, Compare, DecreaseKey>::sift_up(std::vector<Entry_t> &heap, int slot)
+{
+	Entry_t e = heap[slot];
+	while (slot > 0)
+	{
+		int parent = (slot-1) >> 2;
+		if (!m_compare(&heap[parent].m_key, &e.m_key)) { break; }
+		place(heap, slot, heap[parent]);
+		slot = parent;
+	}
+	place(heap, slot, e);
+}
+
+template <typename Node, typename Compare, bool DecreaseKey>
+void BucketOpenList_t<Node, Compare, DecreaseKey>::sift_down(std::vector<Entry_t> &heap, int slot)
+{
+	Entry_t e = heap[slot];
+	int n = heap.size();
+	while (true)
+	{
+		int first = 4*slot + 1;
+		if (first >= n) { break; }
+		// the best of the (up to) four children
+		int best = first;
+		int last = (first+4 < n) ? first+4 : n;
+		for (int c = first+1; c < last; c++)
+		{
+			if (m_compare(&heap[best].m_key, &heap[c].m_key)) { best = c; }
+		}
+		if (!m_compare(&e.m_key, &heap[best].m_key)) { break; }
+		place(heap, slot, heap[best]);
+		slot = best;
+	}
+	place(heap, slot, e);
+}
+
+#endif
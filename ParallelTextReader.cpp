@@ -0,0 +1,74 @@
+/* This cpp file defines a reader which memory-maps a text file, splits it
+into line-aligned chunks and lets the chunks be parsed in parallel */
+
+#include <cstring>
+#include <charconv>
+#include <algorithm>
+
+#include "ParallelTextReader.hpp"
+
+// chunks smaller than this are not worth a thread
+const std::size_t MIN_CHUNK_SIZE = 1 << 18;
+
+bool ParallelTextReader_t::open(std::string file, int nthreads)
+{
+	m_chunks.clear();
+	if (!m_file.open(file)) { return false; }
+	const char *begin = m_file.data();
+	const char *end = begin + m_file.size();
+
+	if (nthreads <= 0)
+	{
+		nthreads = std::max(1u, std::thread::hardware_concurrency());
+	}
+	std::size_t nchunks = std::min<std::size_t>(nthreads, m_file.size() / MIN_CHUNK_SIZE);
+	nchunks = std::max<std::size_t>(nchunks, 1);
+	std::size_t chunkSize = m_file.size() / nchunks;
+	// cut roughly every chunkSize bytes, then move the cut behind the next line break
+	const char *chunkBegin = begin;
+	for (std::size_t c=1; c < nchunks and chunkBegin < end; c++)
+	{
+		const char *cut = std::max(chunkBegin, begin + c*chunkSize);
+		cut = find_lineEnd(cut, end);
+		if (cut < end) { cut++; }
+		m_chunks.push_back(std::make_pair(chunkBegin, cut));
+		chunkBegin = cut;
+	}
+	m_chunks.push_back(std::make_pair(chunkBegin, end));
+
+	return true;
+}
+
+const char* find_lineEnd(const char *p, const char *end)
+{
+	const char *q = static_cast<const char*>(std::memchr(p, '\n', end - p));
+	return (q == nullptr) ? end : q;
+}
+
+static void skip_blanks(const char *&p, const char *lineEnd)
+{
+	while (p < lineEnd and (*p == ' ' or *p == '\t' or *p == '\r' or *p == '\v' or *p == '\f'))
+	{
+		p++;
+	}
+}
+
+bool parse_nextInt(const char *&p, const char *lineEnd, int &value)
+{
+	skip_blanks(p, lineEnd);
+	const char *q = (p < lineEnd and *p == '+') ? p+1 : p;
+	std::from_chars_result r = std::from_chars(q, lineEnd, value);
+	if (r.ec != std::errc()) { return false; }
+	p = r.ptr;
+	return true;
+}
+
+bool parse_nextFloat(const char *&p, const char *lineEnd, float &value)
+{
+	skip_blanks(p, lineEnd);
+	const char *q = (p < lineEnd and *p == '+') ? p+1 : p;
+	std::from_chars_result r = std::from_chars(q, lineEnd, value);
+	if (r.ec != std::errc()) { return false; }
+	p = r.ptr;
+	return true;
+}
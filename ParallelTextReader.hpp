@@ -0,0 +1,55 @@
+/* This hpp file declares a reader which memory-maps a text file, splits it
+into line-aligned chunks and lets the chunks be parsed in parallel */
+
+#ifndef PARALLELTEXTREADER_H
+#define PARALLELTEXTREADER_H
+
+#include <string>
+#include <vector>
+#include <thread>
+#include <utility>
+
+#include "MappedFile.hpp"
+
+class ParallelTextReader_t
+{
+	MappedFile_t m_file;
+	// [begin, end) of every chunk, each chunk holds whole lines
+	std::vector<std::pair<const char*, const char*>> m_chunks;
+
+public:
+	// map the file and split it into chunks for (at most) nthreads threads
+	// nthreads = 0 uses all the hardware threads
+	bool open(std::string file, int nthreads = 0);
+
+	int getnChunks() const { return m_chunks.size(); }
+
+	// call f(chunkIdx, begin, end) for every chunk, one thread per chunk
+	template <typename F>
+	void forEachChunk(F f) const
+	{
+		if (m_chunks.size() == 1)
+		{
+			f(0, m_chunks[0].first, m_chunks[0].second);
+			return;
+		}
+		std::vector<std::thread> workers;
+		for (int c=0; c < m_chunks.size(); c++)
+		{
+			workers.push_back(std::thread(f, c, m_chunks[c].first, m_chunks[c].second));
+		}
+		for (auto &w : workers) { w.join(); }
+	}
+};
+
+// line and token helpers for parsing a chunk
+// (tokens are separated by spaces or tabs, a line may end with "\r\n")
+
+// the end of the line starting at p (the '\n' or end)
+const char* find_lineEnd(const char *p, const char *end);
+// read the next token of the line [p, lineEnd) as a number and move p past it
+// return false (leaving p at the token) if there is no further number in the line
+bool parse_nextInt(const char *&p, const char *lineEnd, int &value);
+bool parse_nextFloat(const char *&p, const char *lineEnd, float &value);
+
+#endif
@@ -0,0 +1,84 @@
+/* This hpp file declares the layout of the binary roadmap bundle, a single
+file holding a whole Graph_t which can be memory-mapped and used in place.
+
+The file starts with a RoadmapBundleHeader_t followed by the sections listed
+in its section table. Every section is a plain array of 32-bit ints or floats
+in native byte order, starting at a 64-byte aligned offset.
+
+Version 2 stores the node states as structure of arrays (see NodeStates.hpp),
+version 3 adds the degree of every row so that a graph which was updated in
+place can be written as is, version 4 adds the ALT landmark tables (empty if
+the graph has none). Older bundles have to be converted again.
+
+The exact cost-to-go of a goal set (see Graph_t::getCostToGo) is kept in a
+sidecar file of its own: a CostToGoHeader_t, the nGoals goal nodes (int) and
+the cost of every node (float). The fingerprint of the edges it was computed
+for is checked when it is loaded. */
+
+#ifndef ROADMAPBUNDLE_H
+#define ROADMAPBUNDLE_H
+
+#include <cstdint>
+
+// "RPLANRMB"
+const char ROADMAP_BUNDLE_MAGIC[8] = {'R', 'P', 'L', 'A', 'N', 'R', 'M', 'B'};
+const std::uint32_t ROADMAP_BUNDLE_VERSION = 4;
+// written as is, reads back differently on a machine with another byte order
+const std::uint32_t ROADMAP_BUNDLE_BYTE_ORDER = 0x01020304;
+const std::uint64_t ROADMAP_BUNDLE_ALIGNMENT = 64;
+
+enum RoadmapBundleSection_t
+{
+	RMB_ADJ_OFFSETS = 0,		// int,   nNodes
+	RMB_ADJ_DEGREES,			// int,   nNodes
+	RMB_ADJ_NODES,				// int,   at least 2*nEdges (rows may have unused room)
+	RMB_ADJ_EDGES,				// int,   same
+	RMB_EDGE_COSTS,				// float, one entry per edge id (at least nEdges)
+	RMB_EDGE_LABEL_SETS,		// int,   same
+	RMB_LABEL_SET_OFFSETS,		// int,   nLabelSets+1
+	RMB_LABEL_ARENA,			// int
+	RMB_NODE_STATES,			// float, nDims*nodeStates_stride(nNodes), dimension by dimension
+	RMB_GOAL_SET,				// int,   nGoals
+	RMB_TARGET_POSES,			// int,   nGoals
+	RMB_LABEL_IDS,				// int,   one entry per line of the label weight file
+	RMB_LABEL_OBSTACLES,		// int,   same
+	RMB_LABEL_WEIGHTS,			// float, same
+	RMB_MOST_PROMISING_LABELS,	// int
+	RMB_LANDMARKS,				// int,   nLandmarks
+	RMB_LANDMARK_DISTANCES,		// float, nLandmarks*nNodes, landmark by landmark
+	RMB_NSECTIONS
+};
+
+struct RoadmapBundleSectionEntry_t
+{
+	std::uint64_t m_offset; // in bytes from the start of the file
+	std::uint64_t m_count; // number of elements
+};
+
+struct RoadmapBundleHeader_t
+{
+	char m_magic[8];
+	std::uint32_t m_version;
+	std::uint32_t m_byteOrder;
+	std::int32_t m_nNodes;
+	std::int32_t m_nDims;
+	std::int32_t m_nEdges;
+	std::int32_t m_start;
+	RoadmapBundleSectionEntry_t m_sections[RMB_NSECTIONS];
+};
+
+// "RPLANCTG"
+const char COST_TO_GO_MAGIC[8] = {'R', 'P', 'L', 'A', 'N', 'C', 'T', 'G'};
+const std::uint32_t COST_TO_GO_VERSION = 1;
+
+struct CostToGoHeader_t
+{
+	char m_magic[8];
+	std::uint32_t m_version;
+	std::uint32_t m_byteOrder; // ROADMAP_BUNDLE_BYTE_ORDER
+	std::int32_t m_nNodes;
+	std::int32_t m_nGoals;
+	std::uint64_t m_edgesFingerprint;
+};
+
+#endif
@@ -0,0 +1,315 @@
+/* This hpp file declares the best-first search shared by all the solvers.
+
+SearchCore_t owns the nodes (in a pool, see NodePool.hpp), the open list,
+the closed list, the path and the results, and runs the search loop. A solver
+derives from it (CRTP) and provides the policies at compile time:
+	Node		the node payload (has m_id, m_f and m_parent, the pool index
+				of the parent)
+	Compare		the priority key of the open list
+	Open		the open list (see OpenList.hpp), lazy by default
+	and, as member functions of the solver:
+	isDominated(n)	dominance rule when n is popped (true: skip it)
+	close(n)		bookkeeping when n is expanded
+	isGoal(n)		goal test
+	relax(g, current, currentIdx, neighbor, e)	dominance rule and push for
+				one edge, a pushed node gets currentIdx as its parent
+	harvest(g, goal)	collect the results once a goal is reached
+isDominated, close, isGoal and harvest have defaults below. The loop is
+instantiated in the solver's own file, so the policies are inlined into it. */
+
+#ifndef SEARCHCORE_H
+#define SEARCHCORE_H
+
+#include <vector>
+#include <fstream>
+#include <iostream>
+#include <algorithm>
+
+#include "Graph.hpp"
+#include "NodePool.hpp"
+#include "OpenList.hpp"
+#include "LabelSet.hpp"
+
+template <typename Derived, typename Node, typename Compare,
+								typename Open = LazyOpenList_t<Node, Compare>>
+class SearchCore_t
+{
+protected:
+	std::vector<int> m_path;
+	std::vector<std::vector<float>> m_trajectory;
+
+	// every node created by the search, freed all at once when the solver goes away
+	NodePool_t<Node> m_nodes;
+	Open m_open;
+	std::vector<int> m_closed;
+
+	int m_start;
+	std::vector<int> m_goalSet;
+	std::vector<int> m_targetPoses;
+	// goal node -> target pose, either the graph's table or m_ownGoalTable
+	const GoalTable_t *m_goalTable;
+	GoalTable_t m_ownGoalTable;
+
+	// the label sets of the nodes, a node holds the id of its set (see LabelSet.hpp)
+	LabelSetTable_t m_labelSets;
+
+	std::ofstream m_outFile_;
+	bool m_isFailure;
+
+	std::vector<int> m_goalLabels;
+	int m_goalIdxReached;
+	int m_obstaclesCollided;
+	bool m_isPathSuccess;
+	float m_pathCost;
+
+	SearchCore_t() : m_open(&m_nodes), m_isFailure(false) {}
+
+	// set the start and the goals (the target poses always come from the graph) and
+	// forget the previous search, if any: the pool, the lists and the results
+	void init_goals(const Graph_t &g, int start, const std::vector<int> &goalSet);
+	// run the search until a goal is expanded or the open list is empty
+	void search(const Graph_t &g);
+
+	// default policies
+	bool isDominated(const Node *n) { return false; }
+	void close(const Node *n) {}
+	bool isGoal(const Node *n) { return m_goalTable->isGoal(n->m_id); }
+	void harvest(const Graph_t &g, const Node *goal) { m_goalLabels = m_labelSets.get(goal->m_labels).toVector(); }
+
+public:
+	void back_track_path();
+	void pathToTrajectory(const Graph_t &g);
+	void writeTrajectory(std::string trajectory_file);
+	void printLabels();
+	void print_path();
+	void print_cost();
+	void print_goalIdxReached();
+	void printAll();
+
+	std::vector<int> label_union(const std::vector<int> &s1, ConstRange_t<int> s2);
+
+	// harvest the results
+	void checkPathSuccess(int nhypo);
+
+	// getters
+	std::vector<int> getPath() {return m_path;}
+	std::vector<int> getGoalLabels() {return m_goalLabels;}
+	int getGoalIdxReached() {return m_goalIdxReached;}
+	std::vector<std::vector<float>> getTrajectory() {return m_trajectory;}
+	bool getFailureIndicator() {return m_isFailure;}
+	int getObstaclesCollided() {return m_obstaclesCollided;}
+	bool getIsPathSuccess() {return m_isPathSuccess;}
+	float getPathCost() {return m_pathCost;}
+};
+
+
+template <typename Derived, typename Node, typename Compare, typename Open>
+void SearchCore_t<Derived, Node, Compare, Open>::init_goals(const Graph_t &g, int start,
+																const std::vector<int> &goalSet)
+{
+	m_nodes.clear();
+	m_closed.clear();
+	m_path.clear();
+	m_trajectory.clear();
+	m_goalLabels.clear();
+	m_isFailure = false;
+	m_start = start;
+	m_goalSet = goalSet;
+	// goal tests go through the graph's table unless the goal set is another one
+	if (m_goalSet == g.getGoalSet())
+	{
+		m_targetPoses = g.getTargetPoses();
+		m_goalTable = &g.getGoalTable();
+	}
+	else
+	{
+		// a goal keeps the target pose the graph gives it (-1 if it is not a goal of the graph)
+		m_targetPoses.assign(m_goalSet.size(), -1);
+		for (int i=0; i < m_goalSet.size(); i++)
+		{
+			if (g.getGoalTable().isGoal(m_goalSet[i]))
+			{
+				m_targetPoses[i] = g.getGoalTable().getTargetPose(m_goalSet[i]);
+			}
+		}
+		m_ownGoalTable.build(g.getnNodes(), m_goalSet, m_targetPoses);
+		m_goalTable = &m_ownGoalTable;
+	}
+	// open list items: the nodes, then a goal copy of every goal
+	m_open.init(g.getnNodes() + m_goalSet.size());
+}
+
+template <typename Derived, typename Node, typename Compare, typename Open>
+void SearchCore_t<Derived, Node, Compare, Open>::search(const Graph_t &g)
+{
+	Derived &solver = static_cast<Derived&>(*this);
+	while (!m_open.empty())
+	{
+		int currentIdx = m_open.pop();
+		Node *current = &m_nodes[currentIdx];
+		// Now check if the current node is still worth expanding
+		if (solver.isDominated(current))
+		{
+			// No need to put it into the closed list, it stays in the pool
+			continue;
+		}
+		m_closed.push_back(currentIdx);
+		solver.close(current);
+
+		// a goal in the goalSet has been found
+		if (solver.isGoal(current))
+		{
+			std::cout << "Goal is connected all the way to the start\n";
+			back_track_path(); // construct your path
+			pathToTrajectory(g); // get the trajectory (a sequence of configurations)
+			solver.harvest(g, current); // get the labels the path carries
+			// print the pose the goal indicates
+			m_goalIdxReached = m_goalTable->getTargetPose(current->m_id);
+			m_pathCost = current->m_f;
+			// std::cout << "The reaching target pose is: " << m_goalIdxReached << "\n";
+			// std::cout << "The cost: " << m_pathCost << "\n";
+			return;
+		}
+		// If it is not the goal, let's keep moving
+		// look at each neighbor of the current node
+		ConstRange_t<int> neighbors = g.getNodeNeighbors(current->m_id);
+		ConstRange_t<int> edges = g.getNodeEdges(current->m_id);
+		for (int k=0; k < neighbors.size(); k++)
+		{
+			solver.relax(g, current, currentIdx, neighbors[k], edges[k]);
+		}
+	}
+	// You are reaching here since the open list is empty and the goal is not found
+	std::cout << "The problem is not solvable. Search failed...\n";
+	m_isFailure = true;
+}
+
+template <typename Derived, typename Node, typename Compare, typename Open>
+void SearchCore_t<Derived, Node, Compare, Open>::checkPathSuccess(int nhypo)
+{
+	m_obstaclesCollided = 0;
+	m_isPathSuccess = true;
+	// compute the obstacles collided
+	// loop through the m_goalLabels
+	for (auto const &l : m_goalLabels)
+	{
+		if (l % nhypo == 0)
+		{
+			m_obstaclesCollided += 1;
+		}
+	}
+	if (m_obstaclesCollided != 0 or m_goalIdxReached != 0)
+	{
+		m_isPathSuccess = false;
+	}
+
+}
+
+template <typename Derived, typename Node, typename Compare, typename Open>
+void SearchCore_t<Derived, Node, Compare, Open>::back_track_path()
+{
+	// start from the goal
+	const Node *current = &m_nodes[m_closed[m_closed.size()-1]];
+	while (current->m_id != m_start)
+	{
+		// keep backtracking the path until you reach the start
+		m_path.push_back(current->m_id);
+		current = &m_nodes[current->m_parent];
+	}
+	// finally put the start into the path
+	m_path.push_back(current->m_id);
+}
+
+template <typename Derived, typename Node, typename Compare, typename Open>
+void SearchCore_t<Derived, Node, Compare, Open>::print_path()
+{
+	// print the path for checking purpose
+	std::cout << "path: \n";
+	for (auto const &waypoint : m_path)
+	{
+		std::cout << waypoint << " ";
+	}
+	std::cout << "\n";
+}
+
+template <typename Derived, typename Node, typename Compare, typename Open>
+void SearchCore_t<Derived, Node, Compare, Open>::printLabels()
+{
+	std::cout << "labels: " << "< ";
+	for (auto const &l : m_goalLabels)
+	{
+		std::cout << l << " ";
+	}
+	std::cout << ">\n";
+}
+
+template <typename Derived, typename Node, typename Compare, typename Open>
+void SearchCore_t<Derived, Node, Compare, Open>::print_cost()
+{
+	std::cout << "cost: " << m_pathCost << "\n";
+}
+
+template <typename Derived, typename Node, typename Compare, typename Open>
+void SearchCore_t<Derived, Node, Compare, Open>::print_goalIdxReached()
+{
+	std::cout << "The reaching target pose is: " << m_goalIdxReached << "\n";
+}
+
+template <typename Derived, typename Node, typename Compare, typename Open>
+void SearchCore_t<Derived, Node, Compare, Open>::printAll()
+{
+	print_path();
+	print_cost();
+	printLabels();
+	print_goalIdxReached();
+}
+
+template <typename Derived, typename Node, typename Compare, typename Open>
+void SearchCore_t<Derived, Node, Compare, Open>::pathToTrajectory(const Graph_t &g)
+{
+	// start from the start
+	for (int i=m_path.size()-1; i >=0; i--)
+	{
+		StridedRange_t<float> state = g.getState(m_path[i]);
+		m_trajectory.push_back(std::vector<float>(state.begin(), state.end()));
+	}
+}
+
+template <typename Derived, typename Node, typename Compare, typename Open>
+void SearchCore_t<Derived, Node, Compare, Open>::writeTrajectory(std::string trajectory_file)
+{
+	m_outFile_.open(trajectory_file);
+	if (m_outFile_.is_open())
+	{
+		for (auto const &t : m_trajectory)
+		{
+			for (auto const &d : t)
+			{
+				m_outFile_ << d << " ";
+			}
+			m_outFile_ << "\n";
+		}
+	}
+	m_outFile_.close();
+}
+
+template <typename Derived, typename Node, typename Compare, typename Open>
+std::vector<int> SearchCore_t<Derived, Node, Compare, Open>::label_union(const std::vector<int> &s1,
+																	ConstRange_t<int> s2)
+{
+	// both sets are already sorted: edge label sets are kept sorted by the graph
+	// and the labels of a node always come from a previous union
+
+	// Declaring resultant vector for union
+	std::vector<int> v(s1.size()+s2.size());
+	// using function set_union() to compute union of 2
+	// containers v1 and v2 and store result in v
+	auto it = std::set_union(s1.begin(), s1.end(), s2.begin(), s2.end(), v.begin());
+
+	// resizing new container
+	v.resize(it - v.begin());
+	return v;
+}
+
+
+#endif
@@ -0,0 +1,110 @@
+/* This hpp file declares the per-node arrays a solver can reset in O(1).
+
+Every entry carries the generation it was last written in. An entry whose
+stamp is not the current generation reads as the fill value, so reset() only
+moves to the next generation instead of filling all the entries again: a
+solver which is reset for a new query pays for the entries its search
+touches, not for the whole graph. The stamps are cleared for real only once
+every 2^32 resets, when the generation wraps around.
+
+StampedArray_t<T> holds a value per entry. StampedSet_t is the flag-only
+version (e.g. expanded nodes): an entry is in the set if its stamp is the
+current generation. */
+
+#ifndef STAMPEDARRAY_H
+#define STAMPEDARRAY_H
+
+#include <vector>
+#include <cstdint>
+
+template <typename T>
+class StampedArray_t
+{
+	struct Entry_t
+	{
+		std::uint32_t m_stamp;
+		T m_value;
+	};
+
+	std::vector<Entry_t> m_entries;
+	std::uint32_t m_generation;
+	T m_fill;
+
+public:
+	StampedArray_t() : m_generation(1), m_fill() {}
+
+	// n entries, all reading as fill. O(1) if the array already has n entries
+	void init(int n, const T &fill);
+	// all the entries back to the fill value
+	void reset();
+
+	// the value of entry i
+	const T& operator[](int i) const
+	{
+		return (m_entries[i].m_stamp == m_generation) ? m_entries[i].m_value : m_fill;
+	}
+	// entry i for writing (set to the fill value first if it is stale)
+	T& at(int i)
+	{
+		Entry_t &e = m_entries[i];
+		if (e.m_stamp != m_generation)
+		{
+			e.m_stamp = m_generation;
+			e.m_value = m_fill;
+		}
+		return e.m_value;
+	}
+	int size() const { return m_entries.size(); }
+};
+
+class StampedSet_t
+{
+	std::vector<std::uint32_t> m_stamps;
+	std::uint32_t m_generation;
+
+public:
+	StampedSet_t() : m_generation(1) {}
+
+	// an empty set of the entries 0 .. n-1. O(1) if the set already has n entries
+	void init(int n)
+	{
+		if ((int)m_stamps.size() != n) { m_stamps.assign(n, 0); m_generation = 1; return; }
+		reset();
+	}
+	// empty the set
+	void reset()
+	{
+		if (++m_generation == 0) { m_stamps.assign(m_stamps.size(), 0); m_generation = 1; }
+	}
+
+	bool operator[](int i) const { return m_stamps[i] == m_generation; }
+	void insert(int i) { m_stamps[i] = m_generation; }
+	int size() const { return m_stamps.size(); }
+};
+
+
+template <typename T>
+void StampedArray_t<T>::init(int n, const T &fill)
+{
+	m_fill = fill;
+	if ((int)m_entries.size() != n)
+	{
+		m_entries.assign(n, Entry_t{0, fill});
+		m_generation = 1;
+		return;
+	}
+	reset();
+}
+
+template <typename T>
+void StampedArray_t<T>::reset()
+{
+	if (++m_generation == 0)
+	{
+		// the generation wrapped around: stamp 0 must not be current again
+		for (auto &e : m_entries) { e.m_stamp = 0; }
+		m_generation = 1;
+	}
+}
+
+#endif
@@ -0,0 +1,57 @@
+/* Convert the text roadmap files (samples, roadmap, label weights and
+most promising labels) into one binary roadmap bundle which Graph_t
+can memory-map and use without parsing.
+
+usage: main_convert <samples_file> <roadmap_file> <labelWeight_file>
+                    <mostPromisingLabels_file> <nsamples> <bundle_file> [nLandmarks]
+
+With nLandmarks the ALT landmark tables (see Graph_t::computeLandmarks) are
+computed and written into the bundle as well. The exact cost-to-go of the goal
+set of the roadmap is written next to the bundle, to <bundle_file>.ctg */
+
+#include <iostream>
+#include <string>
+#include <cstdlib>
+
+#include "Graph.hpp"
+#include "Timer.hpp"
+
+int main(int argc, char** argv)
+{
+	if (argc != 7 and argc != 8)
+	{
+		std::cerr << "usage: " << argv[0] << " <samples_file> <roadmap_file> <labelWeight_file> "
+				<< "<mostPromisingLabels_file> <nsamples> <bundle_file> [nLandmarks]\n";
+		return 1;
+	}
+	Timer t;
+	Graph_t g(argv[1], argv[2], argv[3], argv[4], atoi(argv[5]));
+	std::cout << "Time to import the text roadmap for "
+						<< g.getnNodes() << " nodes: " << t.elapsed() << "\n";
+	if (argc == 8)
+	{
+		t.reset();
+		g.computeLandmarks(atoi(argv[7]));
+		std::cout << "Time to compute " << g.getnLandmarks() << " landmarks: " << t.elapsed() << "\n";
+	}
+	g.write_binaryRoadmap(argv[6]);
+	t.reset();
+	g.write_costToGo(std::string(argv[6]) + ".ctg", g.getGoalSet());
+	std::cout << "Time to compute the cost-to-go of the goal set: " << t.elapsed() << "\n";
+
+	// load it back as a check
+	t.reset();
+	Graph_t g_bundle(argv[6]);
+	std::cout << "Time to map the roadmap bundle: " << t.elapsed() << "\n";
+	if (g_bundle.getnNodes() != g.getnNodes() or g_bundle.getnEdges() != g.getnEdges() or 
+		g_bundle.getnLandmarks() != g.getnLandmarks() or 
+		!g_bundle.load_costToGo(std::string(argv[6]) + ".ctg"))
+	{
+		std::cerr << "The roadmap bundle does not match the text roadmap\n";
+		return 1;
+	}
+	std::cout << g.getnNodes() << " nodes, " << g.getnEdges() << " edges, "
+				<< g.getnLabelSets() << " distinct edge label sets written to " << argv[6] << "\n";
+
+	return 0;
+}
@@ -0,0 +1,87 @@
+/* Check that the MaxSuccess solvers see a label weight update made between
+queries: a solver built before the update must find the same path as a
+solver built after it. The labels updated are moved to new obstacles,
+beyond the ones the solvers were built with.
+
+usage: main_labelWeightTest <samples_file> <roadmap_file> <labelWeight_file>
+                            <mostPromisingLabels_file> <nsamples> [nUpdates]
+
+It returns 1 if a search after an update differs from the fresh one. */
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <set>
+#include <cstdlib>
+
+#include "Graph.hpp"
+#include "MaxSuccessGreedySolver.hpp"
+#include "MaxSuccessExactSolver.hpp"
+
+template <typename Solver_t>
+bool sameResult(Solver_t &s1, Solver_t &s2)
+{
+	return s1.getFailureIndicator() == s2.getFailureIndicator() and
+			s1.getPathCost() == s2.getPathCost() and s1.getPath() == s2.getPath();
+}
+
+int main(int argc, char** argv)
+{
+	if (argc != 6 and argc != 7)
+	{
+		std::cerr << "usage: " << argv[0] << " <samples_file> <roadmap_file> <labelWeight_file> "
+				<< "<mostPromisingLabels_file> <nsamples> [nUpdates]\n";
+		return 1;
+	}
+	Graph_t g(argv[1], argv[2], argv[3], argv[4], atoi(argv[5]));
+	int nUpdates = (argc == 7) ? atoi(argv[6]) : 5;
+
+	// the labels on the edges of the roadmap
+	std::set<int> labels;
+	for (int s=0; s < g.getnLabelSets(); s++)
+	{
+		for (auto const &l : g.getLabelSet(s))
+		{
+			labels.insert(l);
+		}
+	}
+
+	// the solvers are built (and search once) before any update
+	MaxSuccessGreedySolver_t greedy(g);
+	greedy.MSGreedy_search(g);
+	MaxSuccessExactSolver_t exact(g);
+	exact.MSExact_search(g);
+
+	int nFailed = 0;
+	int nDone = 0;
+	for (auto const &l : labels)
+	{
+		if (nDone == nUpdates) { break; }
+		if (!g.setLabelWeight(l, g.getnObstacles()+40, 0.5*(g.getSingleWeight(l)+1.0)))
+		{
+			std::cerr << "The weight of label " << l << " cannot be updated\n";
+			return 1;
+		}
+		nDone++;
+
+		greedy.MSGreedy_search(g);
+		MaxSuccessGreedySolver_t greedy_fresh(g);
+		greedy_fresh.MSGreedy_search(g);
+		exact.MSExact_search(g);
+		MaxSuccessExactSolver_t exact_fresh(g);
+		exact_fresh.MSExact_search(g);
+		if (!sameResult(greedy, greedy_fresh))
+		{
+			std::cerr << "MSGreedy differs after the update of label " << l << "\n";
+			nFailed++;
+		}
+		if (!sameResult(exact, exact_fresh))
+		{
+			std::cerr << "MSExact differs after the update of label " << l << "\n";
+			nFailed++;
+		}
+	}
+	std::cout << nDone << " label weight updates, " << nFailed << " mismatches\n";
+
+	return (nFailed == 0) ? 0 : 1;
+}
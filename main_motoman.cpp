@@ -2,6 +2,7 @@
 #include <fstream>
 #include <string>
 #include <cstdlib>
+#include <memory>
 
 #include "Graph.hpp"
 #include "AstarSolver.hpp"
@@ -26,13 +27,28 @@ int main(int argc, char** argv)
 			+ std::string(argv[2]) + "/labelWeights.txt";
 	std::string mostPromisingLabels_file = "../motoman_manipulation/newChapter/" + std::string(argv[1]) + "/scenario" 
 			+ std::string(argv[2]) + "/mostPromisingLabels.txt";
+	// binary roadmap bundle converted from the files above by main_convert
+	std::string bundle_file = "../motoman_manipulation/newChapter/" + std::string(argv[1]) + "/scenario" 
+			+ std::string(argv[2]) + "/roadmap.bin";
 
 	int nsamples = atoi(argv[3]);
 
 	t.reset();
 	// import the graph
 	float graphConstructionTime;
-	Graph_t g(samples_file, roadmap_file, labelWeight_file, mostPromisingLabels_file, nsamples);
+	// (use the binary roadmap bundle if there is one, it needs no parsing)
+	std::unique_ptr<Graph_t> g_ptr;
+	if (std::ifstream(bundle_file))
+	{
+		g_ptr.reset(new Graph_t(bundle_file));
+	}
+	else
+	{
+		g_ptr.reset(new Graph_t(samples_file, roadmap_file, labelWeight_file, mostPromisingLabels_file, nsamples));
+	}
+	// the queries below only read the graph
+	g_ptr->freeze();
+	const Graph_t &g = *g_ptr;
 	graphConstructionTime = t.elapsed();
 	std::cout << "Time to import the graph for " 
 						<< g.getnNodes() << " nodes: " << graphConstructionTime << "\n\n";